@@ -0,0 +1,251 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <hdf5.h>
+
+#include "H5Support/H5Lite.h"
+#include "H5Support/H5Support.h"
+
+namespace H5Support
+{
+
+/**
+ * @brief The AsyncIO class runs H5Lite reads and writes on a background I/O thread so the calling
+ * threads can keep computing. Requests are executed one at a time in the order they were submitted
+ * and every request returns a std::future holding the herr_t of the H5Lite call.
+ *
+ * The queue is bounded: submitting while it is full blocks until the I/O thread has caught up.
+ * Requests that have not started yet can be cancelled, which resolves their futures with k_Cancelled.
+ *
+ * Ids, names and data buffers passed to a request must stay valid until its future is ready. The
+ * destructor finishes every request that is still queued. Build with H5Support_USE_MUTEX (the default)
+ * when other threads call H5Support while requests are running.
+ */
+class AsyncIO
+{
+public:
+  /**
+   * @brief The value a cancelled request's future resolves to
+   */
+  static constexpr herr_t k_Cancelled = -10000;
+
+  /**
+   * @brief Starts the I/O thread
+   * @param maxQueueDepth The maximum number of requests waiting to be executed
+   */
+  explicit AsyncIO(size_t maxQueueDepth = 16)
+  : m_MaxQueueDepth(std::max<size_t>(maxQueueDepth, 1))
+  {
+    m_Thread = std::thread([this]() { run(); });
+  }
+
+  ~AsyncIO()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Stop = true;
+    }
+    m_NotEmpty.notify_all();
+    m_Thread.join();
+  }
+
+  AsyncIO(const AsyncIO&) = delete;            // Copy Constructor Not Implemented
+  AsyncIO(AsyncIO&&) = delete;                 // Move Constructor Not Implemented
+  AsyncIO& operator=(const AsyncIO&) = delete; // Copy Assignment Not Implemented
+  AsyncIO& operator=(AsyncIO&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief Queues an arbitrary piece of work. Blocks while the queue is full.
+   * @param task The work to run on the I/O thread
+   * @return The future receiving the task's return value, or rethrowing the exception the task threw
+   */
+  std::future<herr_t> submit(std::function<herr_t()> task)
+  {
+    Request request;
+    request.task = std::move(task);
+    std::future<herr_t> future = request.promise.get_future();
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_NotFull.wait(lock, [this]() { return m_Queue.size() < m_MaxQueueDepth; });
+    m_Queue.push_back(std::move(request));
+    lock.unlock();
+    m_NotEmpty.notify_one();
+    return future;
+  }
+
+  /**
+   * @brief Queues H5Lite::readVectorDataset. data is resized by the I/O thread.
+   */
+  template <typename T>
+  std::future<herr_t> readVectorDatasetAsync(hid_t locationID, const std::string& datasetName, std::vector<T>& data)
+  {
+    return submit([locationID, datasetName, &data]() { return H5Lite::readVectorDataset(locationID, datasetName, data); });
+  }
+
+  /**
+   * @brief Queues H5Lite::readPointerDataset into a preallocated array
+   */
+  template <typename T>
+  std::future<herr_t> readPointerDatasetAsync(hid_t locationID, const std::string& datasetName, T* data)
+  {
+    return submit([locationID, datasetName, data]() { return H5Lite::readPointerDataset(locationID, datasetName, data); });
+  }
+
+  /**
+   * @brief Queues H5Lite::writePointerDataset. The dimensions are copied, the data is not.
+   */
+  template <typename T>
+  std::future<herr_t> writePointerDatasetAsync(hid_t locationID, const std::string& datasetName, int32_t rank, const hsize_t* dims, const T* data)
+  {
+    std::vector<hsize_t> vDims(dims, dims + rank);
+    return submit([locationID, datasetName, vDims, data]() { return H5Lite::writePointerDataset(locationID, datasetName, static_cast<int32_t>(vDims.size()), vDims.data(), data); });
+  }
+
+  /**
+   * @brief Queues H5Lite::writeVectorDataset. The request takes ownership of the data, so the
+   * caller can move a buffer in and forget about it.
+   */
+  template <typename T>
+  std::future<herr_t> writeVectorDatasetAsync(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& dims, std::vector<T> data)
+  {
+    auto shared = std::make_shared<std::vector<T>>(std::move(data));
+    return submit([locationID, datasetName, dims, shared]() { return H5Lite::writeVectorDataset(locationID, datasetName, dims, *shared); });
+  }
+
+  /**
+   * @brief Cancels every request that has not started yet. Their futures resolve to k_Cancelled.
+   * @return The number of cancelled requests
+   */
+  size_t cancelPending()
+  {
+    std::deque<Request> cancelled;
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      cancelled.swap(m_Queue);
+    }
+    m_NotFull.notify_all();
+    m_Idle.notify_all();
+    for(auto& request : cancelled)
+    {
+      request.promise.set_value(k_Cancelled);
+    }
+    return cancelled.size();
+  }
+
+  /**
+   * @brief Blocks until every submitted request has finished
+   */
+  void waitForIdle()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Idle.wait(lock, [this]() { return m_Queue.empty() && !m_Busy; });
+  }
+
+  /**
+   * @brief Returns the number of requests waiting to be executed
+   */
+  size_t getPendingCount() const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Queue.size();
+  }
+
+private:
+  struct Request
+  {
+    std::function<herr_t()> task;
+    std::promise<herr_t> promise;
+  };
+
+  void run()
+  {
+    while(true)
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_NotEmpty.wait(lock, [this]() { return m_Stop || !m_Queue.empty(); });
+      if(m_Queue.empty())
+      {
+        return;
+      }
+      Request request = std::move(m_Queue.front());
+      m_Queue.pop_front();
+      m_Busy = true;
+      lock.unlock();
+      m_NotFull.notify_one();
+
+      // An exception from the task is handed to the caller through the future instead of ending the thread
+      try
+      {
+        request.promise.set_value(request.task());
+      } catch(...)
+      {
+        request.promise.set_exception(std::current_exception());
+      }
+
+      lock.lock();
+      m_Busy = false;
+      lock.unlock();
+      m_Idle.notify_all();
+    }
+  }
+
+  size_t m_MaxQueueDepth = 16;
+  std::deque<Request> m_Queue;
+  bool m_Busy = false;
+  bool m_Stop = false;
+  mutable std::mutex m_Mutex;
+  std::condition_variable m_NotEmpty;
+  std::condition_variable m_NotFull;
+  std::condition_variable m_Idle;
+  std::thread m_Thread;
+};
+
+} // namespace H5Support
@@ -0,0 +1,233 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <hdf5.h>
+
+#include "H5Support/H5Handles.h"
+#include "H5Support/H5Lite.h"
+#include "H5Support/H5ObjectCache.h"
+#include "H5Support/H5Support.h"
+
+namespace H5Support
+{
+
+/**
+ * @brief Writes any number of attributes to one object while opening the object only once. Scalar, vector
+ * and string attributes can be mixed. An existing attribute with the same datatype and shape is overwritten
+ * in place; any other existing attribute with the same name is replaced.
+ *
+ * @code
+ * AttributeBatch batch(fileID, "/Data");
+ * batch.writeScalar("Count", 12);
+ * batch.writeString("Units", "mm");
+ * herr_t error = batch.close();
+ * @endcode
+ */
+class AttributeBatch
+{
+public:
+  /**
+   * @brief Opens the object that the attributes get written to
+   * @param locationID The location to look for objectName
+   * @param objectName The dataset or group to write the attributes to
+   */
+  AttributeBatch(hid_t locationID, const std::string& objectName)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    H5O_type_t objectType = H5O_TYPE_UNKNOWN;
+    m_Object.reset(H5ObjectCache::openObject(locationID, objectName, objectType));
+    if(!m_Object.isValid())
+    {
+      std::cout << "Error opening Object for Attribute operations at locationID (" << locationID << ") with object name (" << objectName << ")" << std::endl;
+      m_Error = -1;
+    }
+  }
+
+  ~AttributeBatch() = default;
+
+  AttributeBatch(const AttributeBatch&) = delete;
+  AttributeBatch(AttributeBatch&&) noexcept = default;
+  AttributeBatch& operator=(const AttributeBatch&) = delete;
+  AttributeBatch& operator=(AttributeBatch&&) noexcept = default;
+
+  /**
+   * @brief Returns true while the object is open
+   */
+  bool isValid() const
+  {
+    return m_Object.isValid();
+  }
+
+  /**
+   * @brief Returns the first error of any write in this batch, or 0
+   */
+  herr_t getError() const
+  {
+    return m_Error;
+  }
+
+  /**
+   * @brief Writes an array attribute
+   * @param attributeName The name of the attribute
+   * @param rank The number of dimensions
+   * @param dims The size of each dimension
+   * @param data The data to write
+   * @return Standard HDF5 error condition
+   */
+  template <typename T>
+  herr_t writePointer(const std::string& attributeName, int32_t rank, const hsize_t* dims, const T* data)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    if(!m_Object.isValid())
+    {
+      return -1;
+    }
+    hid_t dataType = H5Lite::HDFTypeForPrimitive<T>();
+    if(dataType == -1)
+    {
+      return record(-1);
+    }
+    DataspaceHandle dataspace(H5Screate_simple(rank, dims, nullptr));
+    if(!dataspace.isValid())
+    {
+      return record(static_cast<herr_t>(dataspace.get()));
+    }
+    return record(H5Lite::detail::writeAttribute(m_Object.get(), attributeName.c_str(), dataType, dataspace.get(), data));
+  }
+
+  /**
+   * @brief Writes an array attribute from a std::vector
+   * @param attributeName The name of the attribute
+   * @param dims The size of each dimension
+   * @param data The data to write
+   * @return Standard HDF5 error condition
+   */
+  template <typename T>
+  herr_t writeVector(const std::string& attributeName, const std::vector<hsize_t>& dims, const std::vector<T>& data)
+  {
+    return writePointer(attributeName, static_cast<int32_t>(dims.size()), dims.data(), data.data());
+  }
+
+  /**
+   * @brief Writes a single value. Like H5Lite::writeScalarAttribute the attribute has one dimension of size 1.
+   * @param attributeName The name of the attribute
+   * @param value The value to write
+   * @return Standard HDF5 error condition
+   */
+  template <typename T>
+  herr_t writeScalar(const std::string& attributeName, T value)
+  {
+    hsize_t dims = 1;
+    return writePointer(attributeName, 1, &dims, &value);
+  }
+
+  /**
+   * @brief Writes a null terminated string attribute
+   * @param attributeName The name of the attribute
+   * @param value The string to write
+   * @return Standard HDF5 error condition
+   */
+  herr_t writeString(const std::string& attributeName, const std::string& value)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    if(!m_Object.isValid())
+    {
+      return -1;
+    }
+    return record(H5Lite::detail::writeStringAttribute(m_Object.get(), attributeName.c_str(), value.size() + 1, value.c_str()));
+  }
+
+  /**
+   * @brief Writes one string attribute for each entry, where the key is the attribute name
+   * @param attributes The attributes to write
+   * @return Standard HDF5 error condition
+   */
+  herr_t writeStrings(const std::map<std::string, std::string>& attributes)
+  {
+    for(const auto& attribute : attributes)
+    {
+      herr_t error = writeString(attribute.first, attribute.second);
+      if(error < 0)
+      {
+        return error;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Closes the object
+   * @return The first error of the batch, or the error of closing the object
+   */
+  herr_t close()
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    herr_t error = m_Object.close();
+    if(error < 0)
+    {
+      std::cout << "Error Closing Object Id" << std::endl;
+      record(error);
+    }
+    return m_Error;
+  }
+
+private:
+  ObjectHandle m_Object;
+  herr_t m_Error = 0;
+
+  herr_t record(herr_t error)
+  {
+    if(error < 0 && m_Error >= 0)
+    {
+      m_Error = error;
+    }
+    return error;
+  }
+};
+
+} // namespace H5Support
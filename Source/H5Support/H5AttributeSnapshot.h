@@ -0,0 +1,478 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <hdf5.h>
+
+#include "H5Support/H5Handles.h"
+#include "H5Support/H5ObjectCache.h"
+#include "H5Support/H5Support.h"
+
+namespace H5Support
+{
+
+/**
+ * @brief Reads every attribute of an object in a single H5Aiterate pass and keeps the values in memory.
+ * Names, dimensions and values are each stored in one contiguous buffer, so reading the metadata of an
+ * object costs one open of the object and one open per attribute instead of one full open/close cycle
+ * per value that is looked up.
+ *
+ * Integer and floating point attributes are read in the native type of the machine and strings (fixed or
+ * variable length) as null terminated text. Attributes of any other class are listed with their type class
+ * and dimensions but have no value.
+ */
+class AttributeSnapshot
+{
+public:
+  using Value = std::variant<std::monostate, int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, float, double, std::string_view>;
+
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  struct Entry
+  {
+    size_t nameOffset = 0;
+    size_t nameLength = 0;
+    size_t dimsOffset = 0;
+    int32_t rank = 0;
+    size_t numElements = 0;
+    size_t valueOffset = 0;
+    // Bytes per element. For strings this is the space for the longest string plus its null terminator.
+    size_t elementSize = 0;
+    H5T_class_t typeClass = H5T_NO_CLASS;
+    H5T_sign_t sign = H5T_SGN_ERROR;
+    bool hasValue = false;
+  };
+
+  AttributeSnapshot() = default;
+
+  /**
+   * @brief Reads all attributes of an object, replacing anything read before
+   * @param locationID The location to look for objectName
+   * @param objectName The dataset or group whose attributes are read
+   * @return Standard HDF5 error condition
+   */
+  herr_t read(hid_t locationID, const std::string& objectName)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    H5O_type_t objectType = H5O_TYPE_UNKNOWN;
+    ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectType));
+    if(!object.isValid())
+    {
+      clear();
+      std::cout << "Error opening Object for Attribute operations at locationID (" << locationID << ") with object name (" << objectName << ")" << std::endl;
+      return -1;
+    }
+    herr_t error = read(object.get());
+    herr_t closeError = object.close();
+    return error < 0 ? error : closeError;
+  }
+
+  /**
+   * @brief Reads all attributes of an object that is already open, replacing anything read before
+   * @param objectID The open dataset or group
+   * @return Standard HDF5 error condition
+   */
+  herr_t read(hid_t objectID)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    clear();
+    H5O_info_t objectInfo{};
+    if(H5Oget_info(objectID, &objectInfo) >= 0)
+    {
+      m_Entries.reserve(static_cast<size_t>(objectInfo.num_attrs));
+    }
+    // Native order does not need HDF5 to sort the attributes first; the entries get sorted by name afterwards
+    VisitData visitData{this, 0};
+    hsize_t index = 0;
+    herr_t error = H5Aiterate(objectID, H5_INDEX_NAME, H5_ITER_NATIVE, &index, visitAttribute, &visitData);
+    if(error < 0)
+    {
+      std::cout << "Error reading the attributes of object " << objectID << std::endl;
+      clear();
+      return error;
+    }
+    std::sort(m_Entries.begin(), m_Entries.end(), [this](const Entry& lhs, const Entry& rhs) { return getName(lhs) < getName(rhs); });
+    return 0;
+  }
+
+  void clear()
+  {
+    m_Entries.clear();
+    m_Names.clear();
+    m_Dims.clear();
+    m_Values.clear();
+  }
+
+  /**
+   * @brief Returns the number of attributes
+   */
+  size_t size() const
+  {
+    return m_Entries.size();
+  }
+
+  /**
+   * @brief Returns the entry at index. Entries are in name order.
+   */
+  const Entry& getEntry(size_t index) const
+  {
+    return m_Entries[index];
+  }
+
+  std::string_view getName(size_t index) const
+  {
+    return getName(m_Entries[index]);
+  }
+
+  std::string_view getName(const Entry& entry) const
+  {
+    return std::string_view(m_Names.data() + entry.nameOffset, entry.nameLength);
+  }
+
+  /**
+   * @brief Returns the index of the named attribute or npos
+   */
+  size_t indexOf(std::string_view attributeName) const
+  {
+    auto iter = std::lower_bound(m_Entries.begin(), m_Entries.end(), attributeName, [this](const Entry& entry, std::string_view name) { return getName(entry) < name; });
+    if(iter == m_Entries.end() || getName(*iter) != attributeName)
+    {
+      return npos;
+    }
+    return static_cast<size_t>(iter - m_Entries.begin());
+  }
+
+  bool contains(std::string_view attributeName) const
+  {
+    return indexOf(attributeName) != npos;
+  }
+
+  /**
+   * @brief Returns the dimensions of the named attribute. A scalar attribute has no dimensions.
+   * @return Negative value if there is no such attribute
+   */
+  herr_t getDims(std::string_view attributeName, std::vector<hsize_t>& dims) const
+  {
+    size_t index = indexOf(attributeName);
+    if(index == npos)
+    {
+      return -1;
+    }
+    const Entry& entry = m_Entries[index];
+    dims.assign(m_Dims.begin() + static_cast<std::ptrdiff_t>(entry.dimsOffset), m_Dims.begin() + static_cast<std::ptrdiff_t>(entry.dimsOffset + entry.rank));
+    return 0;
+  }
+
+  /**
+   * @brief Returns one element of the named attribute. The returned string views point into the snapshot.
+   * @param attributeName The attribute
+   * @param element The element of an array attribute
+   * @return The value, or std::monostate if there is no such attribute or value
+   */
+  Value getValue(std::string_view attributeName, size_t element = 0) const
+  {
+    size_t index = indexOf(attributeName);
+    if(index == npos)
+    {
+      return {};
+    }
+    return getValue(m_Entries[index], element);
+  }
+
+  Value getValue(const Entry& entry, size_t element = 0) const
+  {
+    if(!entry.hasValue || element >= entry.numElements)
+    {
+      return {};
+    }
+    const uint8_t* value = m_Values.data() + entry.valueOffset + element * entry.elementSize;
+    bool isSigned = entry.sign == H5T_SGN_2;
+    switch(entry.typeClass)
+    {
+    case H5T_INTEGER:
+      switch(entry.elementSize)
+      {
+      case 1:
+        return isSigned ? Value(load<int8_t>(value)) : Value(load<uint8_t>(value));
+      case 2:
+        return isSigned ? Value(load<int16_t>(value)) : Value(load<uint16_t>(value));
+      case 4:
+        return isSigned ? Value(load<int32_t>(value)) : Value(load<uint32_t>(value));
+      case 8:
+        return isSigned ? Value(load<int64_t>(value)) : Value(load<uint64_t>(value));
+      default:
+        return {};
+      }
+    case H5T_FLOAT:
+      switch(entry.elementSize)
+      {
+      case sizeof(float):
+        return load<float>(value);
+      case sizeof(double):
+        return load<double>(value);
+      default:
+        return {};
+      }
+    case H5T_STRING: {
+      const char* text = reinterpret_cast<const char*>(value);
+      return std::string_view(text, strnlen(text, entry.elementSize));
+    }
+    default:
+      return {};
+    }
+  }
+
+  /**
+   * @brief Returns the value of a scalar (or the first element of an array) attribute
+   * @return Negative value if there is no such attribute or it does not hold a T
+   */
+  template <typename T>
+  herr_t getScalar(std::string_view attributeName, T& value) const
+  {
+    Value stored = getValue(attributeName);
+    const T* typed = std::get_if<T>(&stored);
+    if(typed == nullptr)
+    {
+      return -1;
+    }
+    value = *typed;
+    return 0;
+  }
+
+  /**
+   * @brief Copies all elements of the named attribute
+   * @return Negative value if there is no such attribute or it does not hold T values
+   */
+  template <typename T>
+  herr_t getVector(std::string_view attributeName, std::vector<T>& values) const
+  {
+    size_t index = indexOf(attributeName);
+    if(index == npos)
+    {
+      return -1;
+    }
+    const Entry& entry = m_Entries[index];
+    Value first = getValue(entry);
+    if(!std::holds_alternative<T>(first) || entry.typeClass == H5T_STRING)
+    {
+      return -1;
+    }
+    values.resize(entry.numElements);
+    std::memcpy(values.data(), m_Values.data() + entry.valueOffset, entry.numElements * sizeof(T));
+    return 0;
+  }
+
+  /**
+   * @brief Copies the value of a string attribute
+   * @return Negative value if there is no such attribute or it is not a string
+   */
+  herr_t getString(std::string_view attributeName, std::string& value) const
+  {
+    Value stored = getValue(attributeName);
+    const std::string_view* text = std::get_if<std::string_view>(&stored);
+    if(text == nullptr)
+    {
+      return -1;
+    }
+    value.assign(text->data(), text->size());
+    return 0;
+  }
+
+private:
+  std::vector<Entry> m_Entries;
+  std::vector<char> m_Names;
+  std::vector<hsize_t> m_Dims;
+  std::vector<uint8_t> m_Values;
+
+  struct VisitData
+  {
+    AttributeSnapshot* snapshot;
+    hsize_t index;
+  };
+
+  template <typename T>
+  static T load(const uint8_t* value)
+  {
+    T result;
+    std::memcpy(&result, value, sizeof(T));
+    return result;
+  }
+
+  /**
+   * @brief Reserves space for numBytes of values, 8 byte aligned, and returns its offset
+   */
+  size_t allocateValue(size_t numBytes)
+  {
+    size_t offset = (m_Values.size() + 7) & ~static_cast<size_t>(7);
+    m_Values.resize(offset + numBytes);
+    return offset;
+  }
+
+  static herr_t visitAttribute(hid_t objectID, const char* name, const H5A_info_t* /*info*/, void* opData)
+  {
+    auto* visitData = static_cast<VisitData*>(opData);
+    AttributeHandle attribute(H5Aopen_by_idx(objectID, ".", H5_INDEX_NAME, H5_ITER_NATIVE, visitData->index++, H5P_DEFAULT, H5P_DEFAULT));
+    if(!attribute.isValid())
+    {
+      return -1;
+    }
+    return visitData->snapshot->readAttribute(attribute.get(), name);
+  }
+
+  herr_t readAttribute(hid_t attributeID, const char* name)
+  {
+    Entry entry;
+    entry.nameOffset = m_Names.size();
+    entry.nameLength = std::strlen(name);
+    m_Names.insert(m_Names.end(), name, name + entry.nameLength + 1);
+
+    TypeHandle attributeType(H5Aget_type(attributeID));
+    DataspaceHandle dataspace(H5Aget_space(attributeID));
+    if(!attributeType.isValid() || !dataspace.isValid())
+    {
+      return -1;
+    }
+    entry.typeClass = H5Tget_class(attributeType.get());
+    entry.rank = H5Sget_simple_extent_ndims(dataspace.get());
+    hssize_t numElements = H5Sget_simple_extent_npoints(dataspace.get());
+    if(entry.rank < 0 || numElements < 0)
+    {
+      return -1;
+    }
+    entry.numElements = static_cast<size_t>(numElements);
+    entry.dimsOffset = m_Dims.size();
+    m_Dims.resize(m_Dims.size() + static_cast<size_t>(entry.rank));
+    H5Sget_simple_extent_dims(dataspace.get(), m_Dims.data() + entry.dimsOffset, nullptr);
+
+    herr_t error = 0;
+    switch(entry.typeClass)
+    {
+    case H5T_INTEGER:
+    case H5T_FLOAT: {
+      TypeHandle nativeType(H5Tget_native_type(attributeType.get(), H5T_DIR_ASCEND));
+      if(!nativeType.isValid())
+      {
+        return -1;
+      }
+      entry.elementSize = H5Tget_size(nativeType.get());
+      entry.sign = entry.typeClass == H5T_INTEGER ? H5Tget_sign(nativeType.get()) : H5T_SGN_ERROR;
+      entry.valueOffset = allocateValue(entry.numElements * entry.elementSize);
+      error = H5Aread(attributeID, nativeType.get(), m_Values.data() + entry.valueOffset);
+      entry.hasValue = error >= 0;
+      break;
+    }
+    case H5T_STRING:
+      error = readStrings(attributeID, attributeType.get(), dataspace.get(), entry);
+      entry.hasValue = error >= 0;
+      break;
+    default:
+      break;
+    }
+    if(error < 0)
+    {
+      std::cout << "Error Reading Attribute '" << name << "'" << std::endl;
+      return error;
+    }
+    m_Entries.push_back(entry);
+    return 0;
+  }
+
+  herr_t readStrings(hid_t attributeID, hid_t attributeType, hid_t dataspace, Entry& entry)
+  {
+    TypeHandle memoryType(H5Tcopy(H5T_C_S1));
+    if(!memoryType.isValid())
+    {
+      return -1;
+    }
+    herr_t error = 0;
+    if(H5Tis_variable_str(attributeType) > 0)
+    {
+      H5Tset_size(memoryType.get(), H5T_VARIABLE);
+      std::vector<char*> strings(entry.numElements, nullptr);
+      error = H5Aread(attributeID, memoryType.get(), strings.data());
+      if(error < 0)
+      {
+        return error;
+      }
+      size_t maxLength = 0;
+      for(const char* text : strings)
+      {
+        maxLength = std::max(maxLength, text == nullptr ? 0 : std::strlen(text));
+      }
+      entry.elementSize = maxLength + 1;
+      entry.valueOffset = allocateValue(entry.numElements * entry.elementSize);
+      for(size_t i = 0; i < entry.numElements; i++)
+      {
+        if(strings[i] != nullptr)
+        {
+          std::memcpy(m_Values.data() + entry.valueOffset + i * entry.elementSize, strings[i], std::strlen(strings[i]));
+        }
+      }
+      return H5Dvlen_reclaim(memoryType.get(), dataspace, H5P_DEFAULT, strings.data());
+    }
+
+    // Fixed length strings are read into slots one byte larger so every element ends up null terminated
+    size_t size = H5Tget_size(attributeType);
+    H5Tset_size(memoryType.get(), size);
+    std::vector<char> buffer(entry.numElements * size);
+    error = H5Aread(attributeID, memoryType.get(), buffer.data());
+    if(error < 0)
+    {
+      return error;
+    }
+    entry.elementSize = size + 1;
+    entry.valueOffset = allocateValue(entry.numElements * entry.elementSize);
+    for(size_t i = 0; i < entry.numElements; i++)
+    {
+      std::memcpy(m_Values.data() + entry.valueOffset + i * entry.elementSize, buffer.data() + i * size, size);
+    }
+    return 0;
+  }
+};
+
+} // namespace H5Support
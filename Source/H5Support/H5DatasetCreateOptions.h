@@ -0,0 +1,341 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hdf5.h>
+
+#include "H5Support/H5Handles.h"
+
+namespace H5Support
+{
+namespace H5Lite
+{
+template <typename T>
+inline hid_t HDFTypeForPrimitive();
+} // namespace H5Lite
+
+/**
+ * @brief Collects the dataset creation settings accepted by the H5Lite write*Dataset functions. Every setter
+ * returns the object so the options can be chained. Anything that is not set keeps the HDF5 default.
+ *
+ * For datasets that are filled region by region later on, setAllocTime(H5D_ALLOC_TIME_LATE) together with
+ * setFillTime(H5D_FILL_TIME_NEVER) keeps the create from writing fill values over the whole dataset first.
+ */
+class DatasetCreateOptions
+{
+public:
+  enum class Layout : int32_t
+  {
+    Default = 0,
+    Contiguous = 1,
+    Chunked = 2,
+    Compact = 3
+  };
+
+  struct Filter
+  {
+    H5Z_filter_t id = H5Z_FILTER_NONE;
+    uint32_t flags = H5Z_FLAG_OPTIONAL;
+    std::vector<uint32_t> values;
+  };
+
+  struct ExternalFile
+  {
+    std::string name;
+    off_t offset = 0;
+    hsize_t size = H5F_UNLIMITED;
+  };
+
+  DatasetCreateOptions() = default;
+
+  /**
+   * @brief Stores the raw data in one block in the file. This is the HDF5 default.
+   */
+  DatasetCreateOptions& setContiguous()
+  {
+    m_Layout = Layout::Contiguous;
+    return *this;
+  }
+
+  /**
+   * @brief Stores the raw data in the object header. Only for datasets smaller than 64 KB; reading one
+   * then takes no extra I/O beyond the object header.
+   */
+  DatasetCreateOptions& setCompact()
+  {
+    m_Layout = Layout::Compact;
+    return *this;
+  }
+
+  /**
+   * @brief Stores the raw data in chunks. Needed for filters.
+   * @param chunkDims The chunk dimensions. If empty, the writers pick them with H5Lite::guessChunkSize.
+   */
+  DatasetCreateOptions& setChunked(const std::vector<hsize_t>& chunkDims = {})
+  {
+    m_Layout = Layout::Chunked;
+    m_ChunkDims = chunkDims;
+    return *this;
+  }
+
+  /**
+   * @brief Adds a filter to the pipeline. Filters run in the order they are added.
+   */
+  DatasetCreateOptions& addFilter(H5Z_filter_t filter, uint32_t flags = H5Z_FLAG_OPTIONAL, const std::vector<uint32_t>& values = {})
+  {
+    m_Filters.push_back({filter, flags, values});
+    return *this;
+  }
+
+  DatasetCreateOptions& setDeflate(uint32_t level)
+  {
+    return addFilter(H5Z_FILTER_DEFLATE, H5Z_FLAG_OPTIONAL, {level});
+  }
+
+  DatasetCreateOptions& setShuffle()
+  {
+    return addFilter(H5Z_FILTER_SHUFFLE);
+  }
+
+  DatasetCreateOptions& setFletcher32()
+  {
+    return addFilter(H5Z_FILTER_FLETCHER32, H5Z_FLAG_MANDATORY);
+  }
+
+  /**
+   * @brief Sets when the file space for the raw data is allocated: H5D_ALLOC_TIME_EARLY at creation,
+   * H5D_ALLOC_TIME_INCR as chunks are written or H5D_ALLOC_TIME_LATE at the first write.
+   */
+  DatasetCreateOptions& setAllocTime(H5D_alloc_time_t allocTime)
+  {
+    m_AllocTime = allocTime;
+    return *this;
+  }
+
+  /**
+   * @brief Sets when fill values are written: H5D_FILL_TIME_ALLOC when space is allocated, H5D_FILL_TIME_NEVER
+   * or H5D_FILL_TIME_IFSET only if a fill value was set.
+   */
+  DatasetCreateOptions& setFillTime(H5D_fill_time_t fillTime)
+  {
+    m_FillTime = fillTime;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the value of elements that were never written. HDF5 converts it to the dataset's datatype.
+   */
+  template <typename T>
+  DatasetCreateOptions& setFillValue(T value)
+  {
+    m_FillValueType = H5Lite::HDFTypeForPrimitive<T>();
+    m_FillValue.resize(sizeof(T));
+    std::memcpy(m_FillValue.data(), &value, sizeof(T));
+    return *this;
+  }
+
+  /**
+   * @brief Stores the raw data in an external file instead of the HDF5 file. Can be called more than once to
+   * spread the data over several files. Only for contiguous datasets without filters.
+   * @param name The external file
+   * @param offset The offset in bytes into the external file
+   * @param size The number of bytes in the external file, H5F_UNLIMITED for the rest of the data
+   */
+  DatasetCreateOptions& addExternalFile(const std::string& name, off_t offset = 0, hsize_t size = H5F_UNLIMITED)
+  {
+    m_ExternalFiles.push_back({name, offset, size});
+    return *this;
+  }
+
+  /**
+   * @brief Returns true if nothing was set, in which case H5P_DEFAULT can be used
+   */
+  bool isDefault() const
+  {
+    return m_Layout == Layout::Default && m_Filters.empty() && !hasAllocTime() && !hasFillTime() && m_FillValue.empty() && m_ExternalFiles.empty();
+  }
+
+  Layout getLayout() const
+  {
+    return m_Layout;
+  }
+
+  /**
+   * @brief Returns true if the dataset will be chunked, either because it was asked for or because there are filters
+   */
+  bool isChunked() const
+  {
+    return m_Layout == Layout::Chunked || (m_Layout == Layout::Default && !m_Filters.empty());
+  }
+
+  /**
+   * @brief Returns true if the layout was left to H5Lite and nothing set needs a contiguous or chunked
+   * dataset, so a small dataset can be given compact layout. Fill settings do not prevent this.
+   */
+  bool allowsCompactLayout() const
+  {
+    return m_Layout == Layout::Default && m_Filters.empty() && !hasAllocTime() && m_ExternalFiles.empty();
+  }
+
+  const std::vector<hsize_t>& getChunkDims() const
+  {
+    return m_ChunkDims;
+  }
+
+  /**
+   * @brief Applies the options to an existing dataset creation property list. Chunked datasets without chunk
+   * dimensions are left for the caller to finish with H5Pset_chunk.
+   * @param datasetCreatePropertyList The property list
+   * @return Standard HDF5 error condition
+   */
+  herr_t apply(hid_t datasetCreatePropertyList) const
+  {
+    herr_t error = 0;
+    switch(m_Layout)
+    {
+    case Layout::Contiguous:
+      error = H5Pset_layout(datasetCreatePropertyList, H5D_CONTIGUOUS);
+      break;
+    case Layout::Compact:
+      error = H5Pset_layout(datasetCreatePropertyList, H5D_COMPACT);
+      break;
+    default:
+      break;
+    }
+    if(error >= 0 && isChunked() && !m_ChunkDims.empty())
+    {
+      error = H5Pset_chunk(datasetCreatePropertyList, static_cast<int>(m_ChunkDims.size()), m_ChunkDims.data());
+    }
+    if(error < 0)
+    {
+      std::cout << "Error setting the dataset layout" << std::endl;
+      return error;
+    }
+    for(const Filter& filter : m_Filters)
+    {
+      error = H5Pset_filter(datasetCreatePropertyList, filter.id, filter.flags, filter.values.size(), filter.values.data());
+      if(error < 0)
+      {
+        std::cout << "Error adding filter " << filter.id << std::endl;
+        return error;
+      }
+    }
+    if(hasAllocTime())
+    {
+      error = H5Pset_alloc_time(datasetCreatePropertyList, m_AllocTime);
+      if(error < 0)
+      {
+        std::cout << "Error setting the allocation time" << std::endl;
+        return error;
+      }
+    }
+    if(hasFillTime())
+    {
+      error = H5Pset_fill_time(datasetCreatePropertyList, m_FillTime);
+      if(error < 0)
+      {
+        std::cout << "Error setting the fill time" << std::endl;
+        return error;
+      }
+    }
+    if(!m_FillValue.empty())
+    {
+      error = H5Pset_fill_value(datasetCreatePropertyList, m_FillValueType, m_FillValue.data());
+      if(error < 0)
+      {
+        std::cout << "Error setting the fill value" << std::endl;
+        return error;
+      }
+    }
+    for(const ExternalFile& file : m_ExternalFiles)
+    {
+      error = H5Pset_external(datasetCreatePropertyList, file.name.c_str(), file.offset, file.size);
+      if(error < 0)
+      {
+        std::cout << "Error adding external file '" << file.name << "'" << std::endl;
+        return error;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Creates a new dataset creation property list with the options applied. The caller must close it.
+   * @return The property list or a negative value on error
+   */
+  hid_t createPropertyList() const
+  {
+    PropertyListHandle datasetCreatePropertyList(H5Pcreate(H5P_DATASET_CREATE));
+    if(!datasetCreatePropertyList.isValid())
+    {
+      return datasetCreatePropertyList.get();
+    }
+    if(apply(datasetCreatePropertyList.get()) < 0)
+    {
+      return -1;
+    }
+    return datasetCreatePropertyList.release();
+  }
+
+private:
+  Layout m_Layout = Layout::Default;
+  std::vector<hsize_t> m_ChunkDims;
+  std::vector<Filter> m_Filters;
+  H5D_alloc_time_t m_AllocTime = H5D_ALLOC_TIME_DEFAULT;
+  H5D_fill_time_t m_FillTime = H5D_FILL_TIME_ERROR;
+  hid_t m_FillValueType = -1;
+  std::vector<uint8_t> m_FillValue;
+  std::vector<ExternalFile> m_ExternalFiles;
+
+  bool hasAllocTime() const
+  {
+    return m_AllocTime != H5D_ALLOC_TIME_DEFAULT;
+  }
+
+  bool hasFillTime() const
+  {
+    return m_FillTime != H5D_FILL_TIME_ERROR;
+  }
+};
+
+} // namespace H5Support
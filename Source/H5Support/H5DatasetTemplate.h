@@ -0,0 +1,237 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hdf5.h>
+
+#include "H5Support/H5DatasetCreateOptions.h"
+#include "H5Support/H5Handles.h"
+#include "H5Support/H5Lite.h"
+#include "H5Support/H5Support.h"
+
+namespace H5Support
+{
+
+/**
+ * @brief Creates any number of datasets of the same type, shape and creation settings. The datatype,
+ * dataspace and the creation and access property lists are built once by the constructor, so each
+ * create() call is only the H5Dcreate and H5Dwrite. The datasets are the same as the ones
+ * H5Lite::writePointerDataset writes with the same options.
+ *
+ * @code
+ * DatasetTemplate<float> grainTemplate({256, 3}, DatasetCreateOptions().setDeflate(5));
+ * for(const Grain& grain : grains)
+ * {
+ *   herr_t error = grainTemplate.create(groupID, grain.name, grain.values.data());
+ * }
+ * @endcode
+ */
+template <typename T>
+class DatasetTemplate
+{
+public:
+  /**
+   * @brief Builds the datatype, dataspace and property lists. Chunked options without chunk dimensions
+   * get the ones H5Lite::guessChunkSize picks for dims.
+   * @param dims The dimensions of every dataset created from this template
+   * @param options The layout, filters, allocation and fill settings of the datasets
+   */
+  explicit DatasetTemplate(const std::vector<hsize_t>& dims, const DatasetCreateOptions& options = DatasetCreateOptions())
+  : m_Dims(dims)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    m_DataType = H5Lite::HDFTypeForPrimitive<T>();
+    if(m_DataType == -1)
+    {
+      m_Error = -1;
+      return;
+    }
+    const int32_t rank = static_cast<int32_t>(m_Dims.size());
+    m_NumElements = 1;
+    for(hsize_t dim : m_Dims)
+    {
+      m_NumElements *= static_cast<size_t>(dim);
+    }
+    m_Dataspace.reset(H5Screate_simple(rank, m_Dims.data(), nullptr));
+    if(!m_Dataspace.isValid())
+    {
+      m_Error = static_cast<herr_t>(m_Dataspace.get());
+      return;
+    }
+    m_CreatePropertyList.reset(H5Lite::detail::createDatasetPropertyList(options, rank, m_Dims.data(), sizeof(T)));
+    if(!m_CreatePropertyList.isValid())
+    {
+      m_Error = -1;
+      return;
+    }
+    m_AccessPropertyList.reset(H5Pcreate(H5P_DATASET_ACCESS));
+    if(!m_AccessPropertyList.isValid())
+    {
+      m_Error = static_cast<herr_t>(m_AccessPropertyList.get());
+    }
+  }
+
+  ~DatasetTemplate() = default;
+
+  DatasetTemplate(const DatasetTemplate&) = delete;
+  DatasetTemplate(DatasetTemplate&&) noexcept = default;
+  DatasetTemplate& operator=(const DatasetTemplate&) = delete;
+  DatasetTemplate& operator=(DatasetTemplate&&) noexcept = default;
+
+  /**
+   * @brief Returns true if everything the template holds was built
+   */
+  bool isValid() const
+  {
+    return m_Error >= 0;
+  }
+
+  /**
+   * @brief Returns the error of building the template, or 0
+   */
+  herr_t getError() const
+  {
+    return m_Error;
+  }
+
+  const std::vector<hsize_t>& getDims() const
+  {
+    return m_Dims;
+  }
+
+  /**
+   * @brief Returns the number of values each dataset holds
+   */
+  size_t getNumElements() const
+  {
+    return m_NumElements;
+  }
+
+  /**
+   * @brief Sets the raw data chunk cache that the datasets are created with. See H5Pset_chunk_cache.
+   * @param numSlots The number of chunk slots in the cache
+   * @param numBytes The size of the cache in bytes
+   * @param w0 The preemption policy
+   * @return Standard HDF5 error condition
+   */
+  herr_t setChunkCache(size_t numSlots, size_t numBytes, double w0)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    if(!isValid())
+    {
+      return -1;
+    }
+    return H5Pset_chunk_cache(m_AccessPropertyList.get(), numSlots, numBytes, w0);
+  }
+
+  /**
+   * @brief Creates a dataset and writes data to it
+   * @param locationID The parent location of the dataset
+   * @param datasetName The name of the dataset
+   * @param data getNumElements() values to write
+   * @return Standard HDF5 error condition
+   */
+  herr_t create(hid_t locationID, const char* datasetName, const T* data) const
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    if(!isValid())
+    {
+      return -1;
+    }
+    if(nullptr == data)
+    {
+      return -2;
+    }
+    DatasetHandle dataset(H5Dcreate(locationID, datasetName, m_DataType, m_Dataspace.get(), H5P_DEFAULT, m_CreatePropertyList.get(), m_AccessPropertyList.get()));
+    if(!dataset.isValid())
+    {
+      return static_cast<herr_t>(dataset.get());
+    }
+    herr_t returnError = 0;
+    herr_t error = H5Dwrite(dataset.get(), m_DataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    if(error < 0)
+    {
+      std::cout << "Error Writing Data '" << datasetName << "'" << std::endl;
+      returnError = error;
+    }
+    error = dataset.close();
+    if(error < 0)
+    {
+      std::cout << "Error Closing Dataset." << std::endl;
+      returnError = error;
+    }
+    return returnError;
+  }
+
+  herr_t create(hid_t locationID, const std::string& datasetName, const T* data) const
+  {
+    return create(locationID, datasetName.c_str(), data);
+  }
+
+  /**
+   * @brief Creates a dataset and writes data to it. The vector must hold getNumElements() values.
+   * @return Standard HDF5 error condition
+   */
+  herr_t create(hid_t locationID, const std::string& datasetName, const std::vector<T>& data) const
+  {
+    if(data.size() != m_NumElements)
+    {
+      std::cout << "DatasetTemplate::create: The data for '" << datasetName << "' has " << data.size() << " values but the template expects " << m_NumElements << std::endl;
+      return -1;
+    }
+    return create(locationID, datasetName.c_str(), data.data());
+  }
+
+private:
+  std::vector<hsize_t> m_Dims;
+  size_t m_NumElements = 0;
+  hid_t m_DataType = -1;
+  DataspaceHandle m_Dataspace;
+  PropertyListHandle m_CreatePropertyList;
+  PropertyListHandle m_AccessPropertyList;
+  herr_t m_Error = 0;
+};
+
+} // namespace H5Support
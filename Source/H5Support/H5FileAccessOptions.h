@@ -0,0 +1,404 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#include <hdf5.h>
+
+#include "H5Support/H5Handles.h"
+
+/**
+ * Define the libraries features and file compatibility that will be used when opening
+ * or creating a file
+ */
+#if(H5_VERS_MINOR == 8)
+#define HDF5_VERSION_LIB_LOWER_BOUNDS H5F_LIBVER_18
+#define HDF5_VERSION_LIB_UPPER_BOUNDS H5F_LIBVER_LATEST
+#endif
+
+#if(H5_VERS_MINOR == 10)
+#define HDF5_VERSION_LIB_LOWER_BOUNDS H5F_LIBVER_V110
+#define HDF5_VERSION_LIB_UPPER_BOUNDS H5F_LIBVER_LATEST
+#endif
+
+#if(H5_VERS_MINOR == 12)
+#define HDF5_VERSION_LIB_LOWER_BOUNDS H5F_LIBVER_V112
+#define HDF5_VERSION_LIB_UPPER_BOUNDS H5F_LIBVER_LATEST
+#endif
+
+#if(H5_VERS_MINOR == 14)
+#define HDF5_VERSION_LIB_LOWER_BOUNDS H5F_LIBVER_V114
+#define HDF5_VERSION_LIB_UPPER_BOUNDS H5F_LIBVER_LATEST
+#endif
+
+#ifndef HDF5_VERSION_LIB_LOWER_BOUNDS
+#error HDF5_VERSION_LIB_LOWER_BOUNDS is not defined. Please check the version of HDF5 that you are compiling against
+#endif
+
+namespace H5Support
+{
+
+/**
+ * @brief Collects the file access settings used by H5Utilities::openFile and H5Utilities::createFile.
+ * Every setter returns the object so the options can be chained:
+ *
+ * @code
+ * FileAccessOptions options;
+ * options.setMetadataCacheSize(64 * 1024 * 1024).setSieveBufferSize(4 * 1024 * 1024).setAlignment(64 * 1024, 1024 * 1024);
+ * hid_t fileID = H5Utilities::openFile(filePath, true, options);
+ * @endcode
+ *
+ * Anything that is not set keeps the HDF5 default, except the library version bounds which default to
+ * HDF5_VERSION_LIB_LOWER_BOUNDS and HDF5_VERSION_LIB_UPPER_BOUNDS.
+ */
+class FileAccessOptions
+{
+public:
+  enum class Driver : int32_t
+  {
+    Sec2 = 0, ///< Unbuffered POSIX I/O (the HDF5 default)
+    Core,     ///< The whole file is held in memory and optionally written back on close
+    Stdio,    ///< Buffered C stdio I/O
+    Family,   ///< The file is split into members of a fixed size. The file name must contain a printf style %d
+    Split     ///< Metadata and raw data are kept in two separate files
+  };
+
+  FileAccessOptions() = default;
+
+  /**
+   * @brief Uses the unbuffered POSIX driver. This is the default.
+   */
+  FileAccessOptions& setSec2Driver()
+  {
+    m_Driver = Driver::Sec2;
+    return *this;
+  }
+
+  /**
+   * @brief Keeps the whole file in memory.
+   * @param incrementSize The number of bytes the memory image grows by
+   * @param backingStore Write the image back to disk when the file is closed
+   */
+  FileAccessOptions& setCoreDriver(size_t incrementSize = 1024 * 1024, bool backingStore = true)
+  {
+    m_Driver = Driver::Core;
+    m_CoreIncrement = incrementSize;
+    m_CoreBackingStore = backingStore;
+    return *this;
+  }
+
+  /**
+   * @brief Uses buffered C stdio calls.
+   */
+  FileAccessOptions& setStdioDriver()
+  {
+    m_Driver = Driver::Stdio;
+    return *this;
+  }
+
+  /**
+   * @brief Splits the file into a family of member files, each at most memberSize bytes.
+   */
+  FileAccessOptions& setFamilyDriver(hsize_t memberSize)
+  {
+    m_Driver = Driver::Family;
+    m_FamilyMemberSize = memberSize;
+    return *this;
+  }
+
+  /**
+   * @brief Writes the metadata and the raw data into two files named after the file name plus an extension.
+   */
+  FileAccessOptions& setSplitDriver(const std::string& metaExtension = "-m.h5", const std::string& rawExtension = "-r.h5")
+  {
+    m_Driver = Driver::Split;
+    m_SplitMetaExtension = metaExtension;
+    m_SplitRawExtension = rawExtension;
+    return *this;
+  }
+
+  /**
+   * @brief Replaces the whole metadata cache configuration. The version field is filled in automatically.
+   */
+  FileAccessOptions& setMetadataCacheConfig(const H5AC_cache_config_t& config)
+  {
+    m_CacheConfig = config;
+    m_CacheConfig.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    m_HasCacheConfig = true;
+    m_MetadataCacheSize = 0;
+    return *this;
+  }
+
+  /**
+   * @brief Starts the metadata cache at size bytes and lets it grow up to maxSize (or size if maxSize is 0)
+   * while keeping the rest of the default adaptive configuration.
+   */
+  FileAccessOptions& setMetadataCacheSize(size_t size, size_t maxSize = 0)
+  {
+    m_MetadataCacheSize = size;
+    m_MetadataCacheMaxSize = std::max(size, maxSize);
+    m_HasCacheConfig = false;
+    return *this;
+  }
+
+  /**
+   * @brief Writes an image of the metadata cache into the file when it is closed. The next open loads the
+   * cached metadata in one sequential read instead of one small read per object. Needs HDF5 1.10.1, a file
+   * with a version 2 or later superblock (the default version bounds give one) and cannot be used with SWMR.
+   * @param saveResizeStatus Also restore the adaptive cache size on the next open
+   * @param entryAgeout The number of opens without an access after which an entry is dropped from the
+   * image, or -1 to keep every entry
+   */
+  FileAccessOptions& setMetadataCacheImage(bool saveResizeStatus = false, int32_t entryAgeout = -1)
+  {
+    m_CacheImage = true;
+    m_CacheImageSaveResizeStatus = saveResizeStatus;
+    m_CacheImageEntryAgeout = entryAgeout;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the page buffer size. The file must have been created with the paged file space strategy.
+   * @param size The size of the page buffer in bytes
+   * @param minMetaPercent The minimum percentage of the buffer kept for metadata pages
+   * @param minRawPercent The minimum percentage of the buffer kept for raw data pages
+   */
+  FileAccessOptions& setPageBufferSize(size_t size, uint32_t minMetaPercent = 0, uint32_t minRawPercent = 0)
+  {
+    m_PageBufferSize = size;
+    m_PageBufferMinMeta = minMetaPercent;
+    m_PageBufferMinRaw = minRawPercent;
+    return *this;
+  }
+
+  /**
+   * @brief Aligns every file object of at least threshold bytes on a multiple of alignment bytes.
+   */
+  FileAccessOptions& setAlignment(hsize_t threshold, hsize_t alignment)
+  {
+    m_AlignmentThreshold = threshold;
+    m_Alignment = alignment;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the size of the buffer used to sieve reads and writes of contiguous datasets.
+   */
+  FileAccessOptions& setSieveBufferSize(size_t size)
+  {
+    m_SieveBufferSize = size;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the earliest and latest library versions whose file format objects may be written.
+   */
+  FileAccessOptions& setLibraryVersionBounds(H5F_libver_t low, H5F_libver_t high)
+  {
+    m_LibverLow = low;
+    m_LibverHigh = high;
+    return *this;
+  }
+
+  Driver getDriver() const
+  {
+    return m_Driver;
+  }
+
+  /**
+   * @brief Applies the options to an existing file access property list.
+   * @param fileAccessPropertyList The property list
+   * @return Standard HDF5 error condition
+   */
+  herr_t apply(hid_t fileAccessPropertyList) const
+  {
+    herr_t error = H5Pset_libver_bounds(fileAccessPropertyList, m_LibverLow, m_LibverHigh);
+    if(error < 0)
+    {
+      std::cout << "Error setting the library version bounds" << std::endl;
+      return error;
+    }
+
+    switch(m_Driver)
+    {
+    case Driver::Sec2:
+      error = H5Pset_fapl_sec2(fileAccessPropertyList);
+      break;
+    case Driver::Core:
+      error = H5Pset_fapl_core(fileAccessPropertyList, m_CoreIncrement, m_CoreBackingStore ? 1 : 0);
+      break;
+    case Driver::Stdio:
+      error = H5Pset_fapl_stdio(fileAccessPropertyList);
+      break;
+    case Driver::Family:
+      error = H5Pset_fapl_family(fileAccessPropertyList, m_FamilyMemberSize, H5P_DEFAULT);
+      break;
+    case Driver::Split:
+      error = H5Pset_fapl_split(fileAccessPropertyList, m_SplitMetaExtension.c_str(), H5P_DEFAULT, m_SplitRawExtension.c_str(), H5P_DEFAULT);
+      break;
+    }
+    if(error < 0)
+    {
+      std::cout << "Error setting the file driver" << std::endl;
+      return error;
+    }
+
+    if(m_HasCacheConfig || m_MetadataCacheSize > 0)
+    {
+      H5AC_cache_config_t config = m_CacheConfig;
+      if(!m_HasCacheConfig)
+      {
+        config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+        error = H5Pget_mdc_config(fileAccessPropertyList, &config);
+        config.set_initial_size = true;
+        config.initial_size = m_MetadataCacheSize;
+        config.min_size = std::min(config.min_size, m_MetadataCacheSize);
+        config.max_size = m_MetadataCacheMaxSize;
+      }
+      if(error >= 0)
+      {
+        error = H5Pset_mdc_config(fileAccessPropertyList, &config);
+      }
+      if(error < 0)
+      {
+        std::cout << "Error setting the metadata cache configuration" << std::endl;
+        return error;
+      }
+    }
+
+    if(m_CacheImage)
+    {
+#if H5_VERSION_GE(1, 10, 1)
+      H5AC_cache_image_config_t imageConfig;
+      imageConfig.version = H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION;
+      imageConfig.generate_image = true;
+      imageConfig.save_resize_status = m_CacheImageSaveResizeStatus;
+      imageConfig.entry_ageout = m_CacheImageEntryAgeout;
+      error = H5Pset_mdc_image_config(fileAccessPropertyList, &imageConfig);
+#else
+      error = -1;
+#endif
+      if(error < 0)
+      {
+        std::cout << "Error setting the metadata cache image configuration" << std::endl;
+        return error;
+      }
+    }
+
+    if(m_PageBufferSize > 0)
+    {
+#if H5_VERSION_GE(1, 10, 1)
+      error = H5Pset_page_buffer_size(fileAccessPropertyList, m_PageBufferSize, m_PageBufferMinMeta, m_PageBufferMinRaw);
+#else
+      error = -1;
+#endif
+      if(error < 0)
+      {
+        std::cout << "Error setting the page buffer size" << std::endl;
+        return error;
+      }
+    }
+
+    if(m_Alignment > 1)
+    {
+      error = H5Pset_alignment(fileAccessPropertyList, m_AlignmentThreshold, m_Alignment);
+      if(error < 0)
+      {
+        std::cout << "Error setting the file alignment" << std::endl;
+        return error;
+      }
+    }
+
+    if(m_SieveBufferSize > 0)
+    {
+      error = H5Pset_sieve_buf_size(fileAccessPropertyList, m_SieveBufferSize);
+      if(error < 0)
+      {
+        std::cout << "Error setting the sieve buffer size" << std::endl;
+        return error;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Creates a new file access property list with the options applied. The caller must close it.
+   * @return The property list or a negative value on error
+   */
+  hid_t createPropertyList() const
+  {
+    PropertyListHandle fileAccessPropertyList(H5Pcreate(H5P_FILE_ACCESS));
+    if(!fileAccessPropertyList.isValid())
+    {
+      return fileAccessPropertyList.get();
+    }
+    if(apply(fileAccessPropertyList.get()) < 0)
+    {
+      return -1;
+    }
+    return fileAccessPropertyList.release();
+  }
+
+private:
+  Driver m_Driver = Driver::Sec2;
+  size_t m_CoreIncrement = 1024 * 1024;
+  bool m_CoreBackingStore = true;
+  hsize_t m_FamilyMemberSize = 0;
+  std::string m_SplitMetaExtension = "-m.h5";
+  std::string m_SplitRawExtension = "-r.h5";
+  H5AC_cache_config_t m_CacheConfig = {};
+  bool m_HasCacheConfig = false;
+  size_t m_MetadataCacheSize = 0;
+  size_t m_MetadataCacheMaxSize = 0;
+  bool m_CacheImage = false;
+  bool m_CacheImageSaveResizeStatus = false;
+  int32_t m_CacheImageEntryAgeout = -1;
+  size_t m_PageBufferSize = 0;
+  uint32_t m_PageBufferMinMeta = 0;
+  uint32_t m_PageBufferMinRaw = 0;
+  hsize_t m_AlignmentThreshold = 1;
+  hsize_t m_Alignment = 1;
+  size_t m_SieveBufferSize = 0;
+  H5F_libver_t m_LibverLow = HDF5_VERSION_LIB_LOWER_BOUNDS;
+  H5F_libver_t m_LibverHigh = HDF5_VERSION_LIB_UPPER_BOUNDS;
+};
+
+} // namespace H5Support
@@ -0,0 +1,180 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <iostream>
+
+#include <hdf5.h>
+
+#include "H5Support/H5Handles.h"
+
+namespace H5Support
+{
+
+/**
+ * @brief Collects the file creation settings used by H5Utilities::createFile. Every setter returns the
+ * object so the options can be chained. Anything that is not set keeps the HDF5 default.
+ */
+class FileCreateOptions
+{
+public:
+  FileCreateOptions() = default;
+
+  /**
+   * @brief Uses the paged file space strategy: metadata and small raw data are aggregated into fixed size
+   * pages, so related metadata ends up next to each other and a page buffer (see
+   * FileAccessOptions::setPageBufferSize) can read it with few large I/Os. Needs HDF5 1.10.1.
+   * @param pageSize The file space page size in bytes, at least 512
+   * @param persistFreeSpace Keep track of free space across opens of the file
+   * @param threshold Free space sections smaller than this are not tracked
+   */
+  FileCreateOptions& setPagedFileSpace(hsize_t pageSize = 4096, bool persistFreeSpace = false, hsize_t threshold = 1)
+  {
+    m_Paged = true;
+    m_PageSize = pageSize;
+    m_PersistFreeSpace = persistFreeSpace;
+    m_FreeSpaceThreshold = threshold;
+    return *this;
+  }
+
+  /**
+   * @brief Keeps track of free space across opens of the file, so the space of deleted or replaced objects is
+   * reused instead of the file growing. Without it, free space is only reused until the file is closed. With the
+   * paged strategy this sets its persistFreeSpace flag. Needs HDF5 1.10.1.
+   * @param threshold Free space sections smaller than this are not tracked
+   */
+  FileCreateOptions& setPersistentFreeSpace(hsize_t threshold = 1)
+  {
+    m_PersistFreeSpace = true;
+    m_FreeSpaceThreshold = threshold;
+    return *this;
+  }
+
+  /**
+   * @brief Reserves a user block of size bytes at the start of the file. Must be 0 or a power of two of at
+   * least 512.
+   */
+  FileCreateOptions& setUserBlockSize(hsize_t size)
+  {
+    m_UserBlockSize = size;
+    return *this;
+  }
+
+  bool isPaged() const
+  {
+    return m_Paged;
+  }
+
+  /**
+   * @brief Applies the options to an existing file creation property list.
+   * @param fileCreatePropertyList The property list
+   * @return Standard HDF5 error condition
+   */
+  herr_t apply(hid_t fileCreatePropertyList) const
+  {
+    herr_t error = 0;
+    if(m_Paged)
+    {
+#if H5_VERSION_GE(1, 10, 1)
+      error = H5Pset_file_space_strategy(fileCreatePropertyList, H5F_FSPACE_STRATEGY_PAGE, m_PersistFreeSpace, m_FreeSpaceThreshold);
+      if(error >= 0)
+      {
+        error = H5Pset_file_space_page_size(fileCreatePropertyList, m_PageSize);
+      }
+#else
+      error = -1;
+#endif
+      if(error < 0)
+      {
+        std::cout << "Error setting the paged file space strategy" << std::endl;
+        return error;
+      }
+    }
+    else if(m_PersistFreeSpace)
+    {
+#if H5_VERSION_GE(1, 10, 1)
+      error = H5Pset_file_space_strategy(fileCreatePropertyList, H5F_FSPACE_STRATEGY_FSM_AGGR, true, m_FreeSpaceThreshold);
+#else
+      error = -1;
+#endif
+      if(error < 0)
+      {
+        std::cout << "Error setting the persistent free space strategy" << std::endl;
+        return error;
+      }
+    }
+
+    if(m_UserBlockSize > 0)
+    {
+      error = H5Pset_userblock(fileCreatePropertyList, m_UserBlockSize);
+      if(error < 0)
+      {
+        std::cout << "Error setting the user block size" << std::endl;
+        return error;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Creates a new file creation property list with the options applied. The caller must close it.
+   * @return The property list or a negative value on error
+   */
+  hid_t createPropertyList() const
+  {
+    PropertyListHandle fileCreatePropertyList(H5Pcreate(H5P_FILE_CREATE));
+    if(!fileCreatePropertyList.isValid())
+    {
+      return fileCreatePropertyList.get();
+    }
+    if(apply(fileCreatePropertyList.get()) < 0)
+    {
+      return -1;
+    }
+    return fileCreatePropertyList.release();
+  }
+
+private:
+  bool m_Paged = false;
+  hsize_t m_PageSize = 4096;
+  bool m_PersistFreeSpace = false;
+  hsize_t m_FreeSpaceThreshold = 1;
+  hsize_t m_UserBlockSize = 0;
+};
+
+} // namespace H5Support
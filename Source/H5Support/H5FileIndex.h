@@ -0,0 +1,419 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <hdf5.h>
+
+#include "H5Support/H5Handles.h"
+#include "H5Support/H5Macros.h"
+#include "H5Support/H5Support.h"
+
+namespace H5Support
+{
+
+/**
+ * @brief An in-memory snapshot of the structure of a file (or of the tree below one of its groups) built with
+ * a single H5Ovisit traversal. Every object records its type and, for datasets, the dimensions, datatype class
+ * and size, layout and filters, along with the names, dimensions and types of its attributes. Once built, the
+ * existence, type and info queries are hash lookups that make no HDF5 calls at all.
+ *
+ * Paths are relative to the location the index was built from; a leading '/' is ignored. The index does not
+ * follow changes made to the file afterwards: call refresh() for the subtree that changed. Objects reachable
+ * through more than one hard link are indexed under the first path H5Ovisit reports. Const queries may run on
+ * several threads at once, but not while the index is built or refreshed.
+ */
+class H5FileIndex
+{
+public:
+  struct AttributeInfo
+  {
+    std::vector<hsize_t> dims;
+    H5T_class_t typeClass = H5T_NO_CLASS;
+    size_t typeSize = 0;
+  };
+
+  struct Node
+  {
+    H5O_type_t type = H5O_TYPE_UNKNOWN;
+    // Dataset only
+    std::vector<hsize_t> dims;
+    H5T_class_t typeClass = H5T_NO_CLASS;
+    size_t typeSize = 0;
+    H5D_layout_t layout = H5D_LAYOUT_ERROR;
+    std::vector<H5Z_filter_t> filters;
+    // Attribute names in name order and their info
+    std::vector<std::string> attributeNames;
+    std::map<std::string, AttributeInfo> attributes;
+    // Names of the children of a group in name order
+    std::vector<std::string> children;
+  };
+
+  H5FileIndex() = default;
+  ~H5FileIndex() = default;
+
+  H5FileIndex(const H5FileIndex&) = default;
+  H5FileIndex(H5FileIndex&&) = default;
+  H5FileIndex& operator=(const H5FileIndex&) = default;
+  H5FileIndex& operator=(H5FileIndex&&) = default;
+
+  /**
+   * @brief Indexes every object below (and including) locationID, replacing anything indexed before.
+   * @param locationID A file or group id
+   * @return Standard HDF5 error condition
+   */
+  herr_t build(hid_t locationID)
+  {
+    m_Nodes.clear();
+    return indexSubtree(locationID, "");
+  }
+
+  /**
+   * @brief Re-indexes the object at path and everything below it. If the object no longer exists it is
+   * dropped from the index.
+   * @param locationID The location the index was built from
+   * @param path The object to refresh
+   * @return Standard HDF5 error condition
+   */
+  herr_t refresh(hid_t locationID, const std::string& path)
+  {
+    const std::string key = normalizePath(path);
+    if(key.empty())
+    {
+      return build(locationID);
+    }
+    for(auto iter = m_Nodes.begin(); iter != m_Nodes.end();)
+    {
+      if(iter->first == key || (iter->first.size() > key.size() && iter->first[key.size()] == '/' && iter->first.compare(0, key.size(), key) == 0))
+      {
+        iter = m_Nodes.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+    auto parent = m_Nodes.find(getParentKey(key));
+    if(parent != m_Nodes.end())
+    {
+      std::vector<std::string>& children = parent->second.children;
+      children.erase(std::remove(children.begin(), children.end(), getNameFromKey(key)), children.end());
+    }
+    return indexSubtree(locationID, key);
+  }
+
+  void clear()
+  {
+    m_Nodes.clear();
+  }
+
+  /**
+   * @brief Returns the number of indexed objects
+   */
+  size_t size() const
+  {
+    return m_Nodes.size();
+  }
+
+  /**
+   * @brief Returns the indexed object at path or nullptr if there is none
+   */
+  const Node* find(const std::string& path) const
+  {
+    auto iter = m_Nodes.find(normalizePath(path));
+    return iter == m_Nodes.end() ? nullptr : &(iter->second);
+  }
+
+  bool objectExists(const std::string& path) const
+  {
+    return find(path) != nullptr;
+  }
+
+  bool isGroup(const std::string& path) const
+  {
+    const Node* node = find(path);
+    return node != nullptr && node->type == H5O_TYPE_GROUP;
+  }
+
+  bool datasetExists(const std::string& path) const
+  {
+    const Node* node = find(path);
+    return node != nullptr && node->type == H5O_TYPE_DATASET;
+  }
+
+  bool attributeExists(const std::string& path, const std::string& attributeName) const
+  {
+    const Node* node = find(path);
+    return node != nullptr && node->attributes.find(attributeName) != node->attributes.end();
+  }
+
+  /**
+   * @brief Same as H5Utilities::getObjectType
+   * @return Negative value if the object is not indexed
+   */
+  herr_t getObjectType(const std::string& path, int32_t& objectType) const
+  {
+    const Node* node = find(path);
+    if(node == nullptr)
+    {
+      return -1;
+    }
+    objectType = node->type;
+    return 0;
+  }
+
+  /**
+   * @brief Same as H5Lite::getDatasetInfo
+   * @return Negative value if the dataset is not indexed
+   */
+  herr_t getDatasetInfo(const std::string& path, std::vector<hsize_t>& dims, H5T_class_t& classType, size_t& sizeType) const
+  {
+    const Node* node = find(path);
+    if(node == nullptr || node->type != H5O_TYPE_DATASET)
+    {
+      return -1;
+    }
+    dims = node->dims;
+    classType = node->typeClass;
+    sizeType = node->typeSize;
+    return 0;
+  }
+
+  /**
+   * @brief Same as H5Lite::getAttributeInfo without the datatype id
+   * @return Negative value if the attribute is not indexed
+   */
+  herr_t getAttributeInfo(const std::string& path, const std::string& attributeName, std::vector<hsize_t>& dims, H5T_class_t& typeClass, size_t& typeSize) const
+  {
+    const Node* node = find(path);
+    if(node == nullptr)
+    {
+      return -1;
+    }
+    auto iter = node->attributes.find(attributeName);
+    if(iter == node->attributes.end())
+    {
+      return -1;
+    }
+    dims = iter->second.dims;
+    typeClass = iter->second.typeClass;
+    typeSize = iter->second.typeSize;
+    return 0;
+  }
+
+  /**
+   * @brief Turns a path into the key used by the index: no leading or trailing '/' and "" for the root.
+   */
+  static std::string normalizePath(const std::string& path)
+  {
+    size_t first = path.find_first_not_of('/');
+    if(first == std::string::npos || path == ".")
+    {
+      return "";
+    }
+    size_t last = path.find_last_not_of('/');
+    return path.substr(first, last - first + 1);
+  }
+
+private:
+  struct VisitData
+  {
+    H5FileIndex* index = nullptr;
+    std::string rootKey;
+    herr_t error = 0;
+  };
+
+  static std::string getParentKey(const std::string& key)
+  {
+    size_t slash = key.rfind('/');
+    return slash == std::string::npos ? std::string() : key.substr(0, slash);
+  }
+
+  static std::string getNameFromKey(const std::string& key)
+  {
+    size_t slash = key.rfind('/');
+    return slash == std::string::npos ? key : key.substr(slash + 1);
+  }
+
+  herr_t indexSubtree(hid_t locationID, const std::string& key)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    HDF_ERROR_HANDLER_OFF
+    ObjectHandle object(H5Oopen(locationID, key.empty() ? "." : key.c_str(), H5P_DEFAULT));
+    HDF_ERROR_HANDLER_ON
+    if(!object.isValid())
+    {
+      // Refreshing an object that was removed
+      return key.empty() ? static_cast<herr_t>(object.get()) : 0;
+    }
+    VisitData data;
+    data.index = this;
+    data.rootKey = key;
+    herr_t error = H5Ovisit(object.get(), H5_INDEX_NAME, H5_ITER_INC, visitObject, &data);
+    if(error < 0 || data.error < 0)
+    {
+      std::cout << "Error indexing the objects below '" << key << "'" << std::endl;
+      return error < 0 ? error : data.error;
+    }
+    return 0;
+  }
+
+  static herr_t visitObject(hid_t rootID, const char* name, const H5O_info_t* info, void* opData)
+  {
+    auto* data = static_cast<VisitData*>(opData);
+    std::string relativeName(name);
+    std::string key = data->rootKey;
+    if(relativeName != ".")
+    {
+      key = key.empty() ? relativeName : key + "/" + relativeName;
+    }
+
+    Node node;
+    node.type = info->type;
+    if(info->type == H5O_TYPE_DATASET || info->num_attrs > 0)
+    {
+      ObjectHandle object(H5Oopen(rootID, name, H5P_DEFAULT));
+      if(!object.isValid())
+      {
+        data->error = -1;
+        return -1;
+      }
+      if(info->type == H5O_TYPE_DATASET)
+      {
+        readDatasetInfo(object.get(), node);
+      }
+      if(info->num_attrs > 0)
+      {
+        hsize_t index = 0;
+        H5Aiterate(object.get(), H5_INDEX_NAME, H5_ITER_INC, &index, visitAttribute, &node);
+      }
+    }
+
+    if(!key.empty())
+    {
+      auto parent = data->index->m_Nodes.find(getParentKey(key));
+      if(parent != data->index->m_Nodes.end())
+      {
+        // A refreshed child can sort before siblings that are already listed
+        std::vector<std::string>& children = parent->second.children;
+        std::string childName = getNameFromKey(key);
+        children.insert(std::lower_bound(children.begin(), children.end(), childName), std::move(childName));
+      }
+    }
+    data->index->m_Nodes[key] = std::move(node);
+    return 0;
+  }
+
+  static void readDatasetInfo(hid_t datasetID, Node& node)
+  {
+    TypeHandle type(H5Dget_type(datasetID));
+    if(type.isValid())
+    {
+      node.typeClass = H5Tget_class(type.get());
+      node.typeSize = H5Tget_size(type.get());
+    }
+    DataspaceHandle dataspace(H5Dget_space(datasetID));
+    if(dataspace.isValid())
+    {
+      int32_t rank = H5Sget_simple_extent_ndims(dataspace.get());
+      if(rank > 0)
+      {
+        node.dims.resize(rank);
+        H5Sget_simple_extent_dims(dataspace.get(), node.dims.data(), nullptr);
+      }
+      else if(node.typeClass == H5T_STRING)
+      {
+        node.dims.push_back(node.typeSize);
+      }
+    }
+    PropertyListHandle propertyList(H5Dget_create_plist(datasetID));
+    if(propertyList.isValid())
+    {
+      node.layout = H5Pget_layout(propertyList.get());
+      int32_t numFilters = H5Pget_nfilters(propertyList.get());
+      for(int32_t i = 0; i < numFilters; i++)
+      {
+        uint32_t flags = 0;
+        size_t numValues = 0;
+        uint32_t filterConfig = 0;
+        node.filters.push_back(H5Pget_filter2(propertyList.get(), static_cast<unsigned>(i), &flags, &numValues, nullptr, 0, nullptr, &filterConfig));
+      }
+    }
+  }
+
+  static herr_t visitAttribute(hid_t objectID, const char* name, const H5A_info_t* /*info*/, void* opData)
+  {
+    auto* node = static_cast<Node*>(opData);
+    AttributeInfo attributeInfo;
+    AttributeHandle attribute(H5Aopen(objectID, name, H5P_DEFAULT));
+    if(attribute.isValid())
+    {
+      TypeHandle type(H5Aget_type(attribute.get()));
+      if(type.isValid())
+      {
+        attributeInfo.typeClass = H5Tget_class(type.get());
+        attributeInfo.typeSize = H5Tget_size(type.get());
+      }
+      DataspaceHandle dataspace(H5Aget_space(attribute.get()));
+      if(attributeInfo.typeClass == H5T_STRING)
+      {
+        attributeInfo.dims.push_back(attributeInfo.typeSize);
+      }
+      else if(dataspace.isValid())
+      {
+        int32_t rank = H5Sget_simple_extent_ndims(dataspace.get());
+        attributeInfo.dims.resize(std::max(rank, 0));
+        H5Sget_simple_extent_dims(dataspace.get(), attributeInfo.dims.data(), nullptr);
+      }
+    }
+    node->attributeNames.emplace_back(name);
+    node->attributes[name] = std::move(attributeInfo);
+    return 0;
+  }
+
+  std::unordered_map<std::string, Node> m_Nodes;
+};
+
+} // namespace H5Support
@@ -0,0 +1,170 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <iostream>
+
+#include <hdf5.h>
+
+#include "H5Support/H5Handles.h"
+
+namespace H5Support
+{
+
+/**
+ * @brief Collects the group creation settings used by H5Utilities::createGroup and
+ * H5Utilities::createGroupsFromPath. Every setter returns the object so the options can be chained.
+ * Anything that is not set keeps the HDF5 default.
+ */
+class GroupCreateOptions
+{
+public:
+  GroupCreateOptions() = default;
+
+  /**
+   * @brief Records the order in which links are created. With an index the members can be listed and
+   * looked up by creation order (H5_INDEX_CRT_ORDER) without sorting the whole group first.
+   * @param indexed Also maintain an index on the creation order
+   */
+  GroupCreateOptions& setCreationOrder(bool indexed = true)
+  {
+    m_CreationOrderFlags = H5P_CRT_ORDER_TRACKED | (indexed ? H5P_CRT_ORDER_INDEXED : 0);
+    return *this;
+  }
+
+  /**
+   * @brief Sets when the group switches between compact storage (links in the object header) and dense
+   * storage (a fractal heap plus B-tree index). Groups known to get large should go dense early.
+   * @param maxCompact The number of links above which the group becomes dense
+   * @param minDense The number of links below which a dense group becomes compact again
+   */
+  GroupCreateOptions& setLinkPhaseChange(uint32_t maxCompact, uint32_t minDense)
+  {
+    m_MaxCompact = maxCompact;
+    m_MinDense = minDense;
+    m_HasPhaseChange = true;
+    return *this;
+  }
+
+  /**
+   * @brief Sizes the group's object header up front for the expected number of links and name length,
+   * so it does not have to be extended as links are added.
+   */
+  GroupCreateOptions& setEstimatedLinkInfo(uint32_t numEntries, uint32_t nameLength)
+  {
+    m_EstimatedEntries = numEntries;
+    m_EstimatedNameLength = nameLength;
+    m_HasEstimate = true;
+    return *this;
+  }
+
+  /**
+   * @brief Returns true if nothing was set, in which case H5P_DEFAULT can be used
+   */
+  bool isDefault() const
+  {
+    return m_CreationOrderFlags == 0 && !m_HasPhaseChange && !m_HasEstimate;
+  }
+
+  /**
+   * @brief Applies the options to an existing group creation property list.
+   * @param groupCreatePropertyList The property list
+   * @return Standard HDF5 error condition
+   */
+  herr_t apply(hid_t groupCreatePropertyList) const
+  {
+    herr_t error = 0;
+    if(m_CreationOrderFlags != 0)
+    {
+      error = H5Pset_link_creation_order(groupCreatePropertyList, m_CreationOrderFlags);
+      if(error < 0)
+      {
+        std::cout << "Error setting the link creation order" << std::endl;
+        return error;
+      }
+    }
+    if(m_HasPhaseChange)
+    {
+      error = H5Pset_link_phase_change(groupCreatePropertyList, m_MaxCompact, m_MinDense);
+      if(error < 0)
+      {
+        std::cout << "Error setting the link phase change" << std::endl;
+        return error;
+      }
+    }
+    if(m_HasEstimate)
+    {
+      error = H5Pset_est_link_info(groupCreatePropertyList, m_EstimatedEntries, m_EstimatedNameLength);
+      if(error < 0)
+      {
+        std::cout << "Error setting the estimated link info" << std::endl;
+        return error;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Creates a new group creation property list with the options applied. The caller must close it.
+   * @return The property list or a negative value on error
+   */
+  hid_t createPropertyList() const
+  {
+    PropertyListHandle groupCreatePropertyList(H5Pcreate(H5P_GROUP_CREATE));
+    if(!groupCreatePropertyList.isValid())
+    {
+      return groupCreatePropertyList.get();
+    }
+    if(apply(groupCreatePropertyList.get()) < 0)
+    {
+      return -1;
+    }
+    return groupCreatePropertyList.release();
+  }
+
+private:
+  uint32_t m_CreationOrderFlags = 0;
+  bool m_HasPhaseChange = false;
+  uint32_t m_MaxCompact = 8;
+  uint32_t m_MinDense = 6;
+  bool m_HasEstimate = false;
+  uint32_t m_EstimatedEntries = 4;
+  uint32_t m_EstimatedNameLength = 8;
+};
+
+} // namespace H5Support
@@ -0,0 +1,212 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include <hdf5.h>
+
+#include "H5Support/H5ObjectCache.h"
+#include "H5Support/H5Support.h"
+
+/**
+ * @brief An optional, per file set of group paths that are known to exist. Once enabled for a file,
+ * H5Utilities::createGroupsFromPath (and so createGroupsForDataset) records every group path it creates or
+ * finds and skips any path it has seen before, so writing many datasets below the same groups does not probe
+ * the file for those groups again.
+ *
+ * The set only learns about groups through H5Support. Groups that are unlinked or moved outside of H5Support
+ * need to be removed with invalidate(). H5Utilities::closeFile disables the cache of the file it closes.
+ * The functions that resolve ids through HDF5 take the library lock before the lock of the registry.
+ */
+namespace H5Support
+{
+namespace H5GroupPathCache
+{
+namespace detail
+{
+/**
+ * @brief Holds the known group paths of every file that has the cache enabled, keyed by file id
+ */
+struct Registry
+{
+  std::mutex mutex;
+  std::map<hid_t, std::unordered_set<std::string>> paths;
+};
+
+inline Registry& getRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+} // namespace detail
+
+/**
+ * @brief Enables the group path cache for a file. Enabling it again changes nothing.
+ * @param fileID The file id
+ * @return Standard HDF5 error condition
+ */
+inline herr_t enable(hid_t fileID)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(H5Iget_type(fileID) != H5I_FILE)
+  {
+    return -1;
+  }
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.paths[fileID];
+  return 0;
+}
+
+/**
+ * @brief Forgets every known path of a file and disables its cache
+ * @param fileID The file id
+ * @return Standard HDF5 error condition
+ */
+inline herr_t disable(hid_t fileID)
+{
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.paths.erase(fileID);
+  return 0;
+}
+
+/**
+ * @brief Returns true if the cache is enabled for the given file
+ * @param fileID The file id
+ */
+inline bool isEnabled(hid_t fileID)
+{
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.paths.find(fileID) != registry.paths.end();
+}
+
+/**
+ * @brief Returns true if the group at groupPath is known to exist
+ * @param locationID The parent location
+ * @param groupPath The path of the group relative to locationID
+ */
+inline bool contains(hid_t locationID, const std::string& groupPath)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if(registry.paths.empty())
+  {
+    return false;
+  }
+  std::string path;
+  auto iter = registry.paths.find(H5ObjectCache::detail::resolve(locationID, groupPath.c_str(), path));
+  return iter != registry.paths.end() && iter->second.find(path) != iter->second.end();
+}
+
+/**
+ * @brief Records that the group at groupPath, and so every group above it, exists
+ * @param locationID The parent location
+ * @param groupPath The path of the group relative to locationID
+ */
+inline void insert(hid_t locationID, const std::string& groupPath)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if(registry.paths.empty())
+  {
+    return;
+  }
+  std::string path;
+  auto iter = registry.paths.find(H5ObjectCache::detail::resolve(locationID, groupPath.c_str(), path));
+  if(iter == registry.paths.end())
+  {
+    return;
+  }
+  for(size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1))
+  {
+    iter->second.insert(path.substr(0, slash));
+  }
+  iter->second.insert(path);
+}
+
+/**
+ * @brief Forgets a group path and every path below it. Call this before unlinking or moving a group
+ * outside of H5Support.
+ * @param locationID The parent location
+ * @param groupPath The path of the group relative to locationID
+ * @return Standard HDF5 error condition
+ */
+inline herr_t invalidate(hid_t locationID, const std::string& groupPath)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if(registry.paths.empty())
+  {
+    return 0;
+  }
+  std::string path;
+  auto iter = registry.paths.find(H5ObjectCache::detail::resolve(locationID, groupPath.c_str(), path));
+  if(iter == registry.paths.end())
+  {
+    return 0;
+  }
+  std::unordered_set<std::string>& paths = iter->second;
+  for(auto pathIter = paths.begin(); pathIter != paths.end();)
+  {
+    if(pathIter->compare(0, path.size(), path) == 0 && (pathIter->size() == path.size() || (*pathIter)[path.size()] == '/'))
+    {
+      pathIter = paths.erase(pathIter);
+    }
+    else
+    {
+      ++pathIter;
+    }
+  }
+  return 0;
+}
+
+} // namespace H5GroupPathCache
+} // namespace H5Support
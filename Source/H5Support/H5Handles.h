@@ -0,0 +1,157 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <utility>
+
+#include <hdf5.h>
+
+namespace H5Support
+{
+
+/**
+ * @brief Move-only owner of an HDF5 identifier that closes it with CloseFunc when it goes out of scope.
+ * A handle is the size of an hid_t and all of its members are inline, so using one costs nothing over
+ * calling the close function by hand. close() can be called early to check the result of closing.
+ */
+template <herr_t (*CloseFunc)(hid_t)>
+class H5Handle
+{
+public:
+  H5Handle() = default;
+
+  explicit H5Handle(hid_t id)
+  : m_Id(id)
+  {
+  }
+
+  ~H5Handle()
+  {
+    close();
+  }
+
+  H5Handle(const H5Handle&) = delete;            // Copy Constructor Not Implemented
+  H5Handle& operator=(const H5Handle&) = delete; // Copy Assignment Not Implemented
+
+  H5Handle(H5Handle&& other) noexcept
+  : m_Id(other.release())
+  {
+  }
+
+  H5Handle& operator=(H5Handle&& other) noexcept
+  {
+    if(this != &other)
+    {
+      close();
+      m_Id = other.release();
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Returns the identifier without giving up ownership
+   */
+  hid_t get() const
+  {
+    return m_Id;
+  }
+
+  /**
+   * @brief Returns true if the handle holds a valid (non negative) identifier
+   */
+  bool isValid() const
+  {
+    return m_Id >= 0;
+  }
+
+  explicit operator bool() const
+  {
+    return isValid();
+  }
+
+  /**
+   * @brief Gives up ownership of the identifier without closing it
+   * @return The identifier
+   */
+  hid_t release()
+  {
+    hid_t id = m_Id;
+    m_Id = -1;
+    return id;
+  }
+
+  /**
+   * @brief Closes the identifier now and takes ownership of another one
+   */
+  void reset(hid_t id = -1)
+  {
+    close();
+    m_Id = id;
+  }
+
+  /**
+   * @brief Closes the identifier. Closing an empty handle does nothing.
+   * @return The result of the close function, 0 for an empty handle
+   */
+  herr_t close()
+  {
+    herr_t error = 0;
+    if(m_Id >= 0)
+    {
+      error = CloseFunc(m_Id);
+      m_Id = -1;
+    }
+    return error;
+  }
+
+private:
+  hid_t m_Id = -1;
+};
+
+using FileHandle = H5Handle<H5Fclose>;
+using GroupHandle = H5Handle<H5Gclose>;
+using DatasetHandle = H5Handle<H5Dclose>;
+using DataspaceHandle = H5Handle<H5Sclose>;
+using TypeHandle = H5Handle<H5Tclose>;
+using AttributeHandle = H5Handle<H5Aclose>;
+using PropertyListHandle = H5Handle<H5Pclose>;
+/**
+ * @brief Owns a dataset, group or named datatype opened through the generic H5O interface
+ */
+using ObjectHandle = H5Handle<H5Oclose>;
+
+} // namespace H5Support
@@ -49,9 +49,22 @@
 
 #include <hdf5.h>
 
+#include "H5Support/H5DatasetCreateOptions.h"
+#include "H5Support/H5Handles.h"
 #include "H5Support/H5Macros.h"
+#include "H5Support/H5ObjectCache.h"
+#include "H5Support/H5Path.h"
+#include "H5Support/H5ScopedErrorHandler.h"
 #include "H5Support/H5Support.h"
 
+#if defined(H5Support_USE_PARALLEL_DEFLATE) && defined(H5_HAVE_FILTER_DEFLATE) && H5_VERSION_GE(1, 10, 5)
+#define H5Support_HAVE_PARALLEL_DEFLATE
+#include <atomic>
+#include <thread>
+
+#include <zlib.h>
+#endif
+
 /**
  * @brief Namespace to bring together some high level methods to read/write data to HDF5 files.
  * @author Mike Jackson
@@ -158,6 +171,40 @@ inline void disableErrorHandlers()
   HDF_ERROR_HANDLER_OFF
 }
 
+/**
+ * @brief The largest raw data size that HDF5 can keep in an object header
+ */
+inline constexpr size_t k_MaxCompactLayoutSize = 64000;
+
+namespace detail
+{
+inline std::atomic<size_t>& compactLayoutThreshold()
+{
+  static std::atomic<size_t> threshold(1024);
+  return threshold;
+}
+} // namespace detail
+
+/**
+ * @brief Sets the size in bytes up to which the write*Dataset functions give new datasets compact
+ * layout, which keeps the raw data in the object header so reading it needs no extra I/O. Datasets
+ * whose options ask for a layout, filters, an allocation time or external files are not affected.
+ * The default is 1024 bytes. Values above k_MaxCompactLayoutSize are clamped and 0 turns this off.
+ * @param numBytes The threshold in bytes
+ */
+inline void setCompactLayoutThreshold(size_t numBytes)
+{
+  detail::compactLayoutThreshold() = std::min(numBytes, k_MaxCompactLayoutSize);
+}
+
+/**
+ * @brief Returns the size in bytes up to which new datasets get compact layout
+ */
+inline size_t getCompactLayoutThreshold()
+{
+  return detail::compactLayoutThreshold();
+}
+
 /**
  * @brief Opens an object for HDF5 operations
  * @param locationID The parent object that holds the true object we want to open
@@ -550,14 +597,23 @@ inline hid_t HDFTypeForPrimitive()
  * @brief Inquires if an attribute named attributeName exists attached to the object locationID.
  * @param locationID The location to search
  * @param attributeName The attribute to search for
- * @return Standard HDF5 Error condition
+ * @return 1 if the attribute exists, 0 if it does not and negative on error
  */
-inline herr_t findAttribute(hid_t locationID, const std::string& attributeName)
+inline herr_t findAttribute(hid_t locationID, const char* attributeName)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hsize_t attributeNum = 0;
-  return H5Aiterate(locationID, H5_INDEX_NAME, H5_ITER_INC, &attributeNum, find_attr, const_cast<char*>(attributeName.c_str()));
+  // H5Aexists uses the attribute name index instead of iterating over every attribute
+  htri_t exists = H5Aexists(locationID, attributeName);
+  return exists > 0 ? 1 : static_cast<herr_t>(exists);
+}
+
+/**
+ * @brief std::string overload of findAttribute
+ */
+inline herr_t findAttribute(hid_t locationID, const std::string& attributeName)
+{
+  return findAttribute(locationID, attributeName.c_str());
 }
 
 /**
@@ -566,17 +622,194 @@ inline herr_t findAttribute(hid_t locationID, const std::string& attributeName)
  * @param datasetName The dataset to search for
  * @return Standard HDF5 Error condition. Negative=DataSet
  */
-inline bool datasetExists(hid_t locationID, const std::string& datasetName)
+inline bool datasetExists(hid_t locationID, const char* datasetName)
 {
   H5SUPPORT_MUTEX_LOCK()
 
   H5O_info_t objectInfo{};
   HDF_ERROR_HANDLER_OFF
-  herr_t error = H5Oget_info_by_name(locationID, datasetName.c_str(), &objectInfo, H5P_DEFAULT);
+  herr_t error = H5Oget_info_by_name(locationID, datasetName, &objectInfo, H5P_DEFAULT);
   HDF_ERROR_HANDLER_ON
   return error >= 0;
 }
 
+/**
+ * @brief std::string overload of datasetExists
+ */
+inline bool datasetExists(hid_t locationID, const std::string& datasetName)
+{
+  return datasetExists(locationID, datasetName.c_str());
+}
+
+namespace detail
+{
+/**
+ * @brief Returns true if an open attribute already has the given datatype and the extent of the given dataspace
+ */
+inline bool attributeMatches(hid_t attributeID, hid_t dataType, hid_t dataspaceID)
+{
+  TypeHandle attributeType(H5Aget_type(attributeID));
+  if(!attributeType.isValid() || H5Tequal(attributeType.get(), dataType) <= 0)
+  {
+    return false;
+  }
+  DataspaceHandle attributeSpace(H5Aget_space(attributeID));
+  if(!attributeSpace.isValid() || H5Sget_simple_extent_type(attributeSpace.get()) != H5Sget_simple_extent_type(dataspaceID))
+  {
+    return false;
+  }
+  int32_t rank = H5Sget_simple_extent_ndims(dataspaceID);
+  if(rank < 0 || H5Sget_simple_extent_ndims(attributeSpace.get()) != rank)
+  {
+    return false;
+  }
+  std::vector<hsize_t> dims(static_cast<size_t>(rank));
+  std::vector<hsize_t> attributeDims(static_cast<size_t>(rank));
+  H5Sget_simple_extent_dims(dataspaceID, dims.data(), nullptr);
+  H5Sget_simple_extent_dims(attributeSpace.get(), attributeDims.data(), nullptr);
+  return dims == attributeDims;
+}
+
+/**
+ * @brief Writes an attribute on an object that is already open. An existing attribute with the same
+ * datatype and dataspace is overwritten in place. Any other existing attribute is deleted and created again.
+ * @param objectID The open object
+ * @param attributeName The name of the attribute
+ * @param dataType The datatype of the attribute and of the data in memory
+ * @param dataspaceID The dataspace of the attribute
+ * @param data The data to write
+ * @return Standard HDF5 error condition
+ */
+inline herr_t writeAttribute(hid_t objectID, const char* attributeName, hid_t dataType, hid_t dataspaceID, const void* data)
+{
+  herr_t error = 0;
+  htri_t exists = H5Aexists(objectID, attributeName);
+  if(exists < 0)
+  {
+    return static_cast<herr_t>(exists);
+  }
+  AttributeHandle attribute;
+  if(exists > 0)
+  {
+    attribute.reset(H5Aopen(objectID, attributeName, H5P_DEFAULT));
+    if(attribute.isValid() && !attributeMatches(attribute.get(), dataType, dataspaceID))
+    {
+      attribute.close();
+      error = H5Adelete(objectID, attributeName);
+      if(error < 0)
+      {
+        std::cout << "Error Deleting Existing Attribute '" << attributeName << "'" << std::endl;
+        return error;
+      }
+    }
+  }
+  if(!attribute.isValid())
+  {
+    attribute.reset(H5Acreate(objectID, attributeName, dataType, dataspaceID, H5P_DEFAULT, H5P_DEFAULT));
+    if(!attribute.isValid())
+    {
+      std::cout << "Error Creating Attribute '" << attributeName << "'" << std::endl;
+      return static_cast<herr_t>(attribute.get());
+    }
+  }
+  herr_t returnError = 0;
+  error = H5Awrite(attribute.get(), dataType, data);
+  if(error < 0)
+  {
+    std::cout << "Error Writing Attribute '" << attributeName << "'" << std::endl;
+    returnError = error;
+  }
+  error = attribute.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Attribute" << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+
+/**
+ * @brief Writes a fixed length, null terminated string attribute on an object that is already open
+ * @param objectID The open object
+ * @param attributeName The name of the attribute
+ * @param size The size of the string including the null terminator
+ * @param data The string to write
+ * @return Standard HDF5 error condition
+ */
+inline herr_t writeStringAttribute(hid_t objectID, const char* attributeName, hsize_t size, const char* data)
+{
+  TypeHandle attributeType(H5Tcopy(H5T_C_S1));
+  if(!attributeType.isValid())
+  {
+    return static_cast<herr_t>(attributeType.get());
+  }
+  if(H5Tset_size(attributeType.get(), size) < 0 || H5Tset_strpad(attributeType.get(), H5T_STR_NULLTERM) < 0)
+  {
+    std::cout << "Error Setting the String Type of Attribute '" << attributeName << "'" << std::endl;
+    return -1;
+  }
+  DataspaceHandle dataspace(H5Screate(H5S_SCALAR));
+  if(!dataspace.isValid())
+  {
+    return static_cast<herr_t>(dataspace.get());
+  }
+  return writeAttribute(objectID, attributeName, attributeType.get(), dataspace.get(), data);
+}
+} // namespace detail
+
+inline std::vector<hsize_t> guessChunkSize(int32_t rank, const hsize_t* dims, size_t typeSize);
+
+namespace detail
+{
+/**
+ * @brief Returns true if a dataset of the given size falls under the compact layout threshold and
+ * its options leave the layout to H5Lite
+ */
+inline bool useCompactLayout(const DatasetCreateOptions& options, int32_t rank, const hsize_t* dims, size_t typeSize)
+{
+  if(!options.allowsCompactLayout())
+  {
+    return false;
+  }
+  size_t numBytes = typeSize;
+  for(int32_t i = 0; i < rank; ++i)
+  {
+    numBytes *= dims[i];
+  }
+  return numBytes > 0 && numBytes <= getCompactLayoutThreshold();
+}
+
+/**
+ * @brief Creates the dataset creation property list for a set of options. Chunked options without chunk
+ * dimensions get the ones guessChunkSize picks for the dataset and datasets under the compact layout
+ * threshold get compact layout. The caller must close the property list.
+ * @return The property list or a negative value on error
+ */
+inline hid_t createDatasetPropertyList(const DatasetCreateOptions& options, int32_t rank, const hsize_t* dims, size_t typeSize)
+{
+  PropertyListHandle createPropertyList(options.createPropertyList());
+  if(!createPropertyList.isValid())
+  {
+    return -1;
+  }
+  if(useCompactLayout(options, rank, dims, typeSize) && H5Pset_layout(createPropertyList.get(), H5D_COMPACT) < 0)
+  {
+    std::cout << "Error setting the compact layout" << std::endl;
+    return -1;
+  }
+  if(options.isChunked() && options.getChunkDims().empty())
+  {
+    std::vector<hsize_t> chunkDims = guessChunkSize(rank, dims, typeSize);
+    if(H5Pset_chunk(createPropertyList.get(), rank, chunkDims.data()) < 0)
+    {
+      std::cout << "Error setting the chunk dimensions" << std::endl;
+      return -1;
+    }
+  }
+  return createPropertyList.release();
+}
+} // namespace detail
+
 /**
  * @brief Writes the data of a pointer to an HDF5 file
  * @param locationID The hdf5 object id of the parent
@@ -584,10 +817,11 @@ inline bool datasetExists(hid_t locationID, const std::string& datasetName)
  * @param rank The number of dimensions
  * @param dims The sizes of each dimension
  * @param data The data to be written.
+ * @param options The layout, filters, allocation and fill settings of the new dataset
  * @return Standard hdf5 error condition.
  */
 template <typename T>
-inline herr_t writePointerDataset(hid_t locationID, const std::string& datasetName, int32_t rank, const hsize_t* dims, const T* data)
+inline herr_t writePointerDataset(hid_t locationID, const std::string& datasetName, int32_t rank, const hsize_t* dims, const T* data, const DatasetCreateOptions& options)
 {
   H5SUPPORT_MUTEX_LOCK()
   herr_t returnError = 0;
@@ -602,45 +836,51 @@ inline herr_t writePointerDataset(hid_t locationID, const std::string& datasetNa
     return -1;
   }
   // Create the DataSpace
-  hid_t dataspaceID = H5Screate_simple(rank, dims, nullptr);
-  if(dataspaceID < 0)
+  DataspaceHandle dataspace(H5Screate_simple(rank, dims, nullptr));
+  if(!dataspace.isValid())
   {
-    return static_cast<herr_t>(dataspaceID);
+    return static_cast<herr_t>(dataspace.get());
   }
-  // Create the Dataset
-  // This will fail if datasetName contains a "/"!
-  hid_t datasetID = H5Dcreate(locationID, datasetName.c_str(), dataType, dataspaceID, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-  if(datasetID >= 0)
+  PropertyListHandle createPropertyList;
+  if(!options.isDefault() || detail::useCompactLayout(options, rank, dims, sizeof(T)))
   {
-    herr_t error = H5Dwrite(datasetID, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
-    if(error < 0)
+    createPropertyList.reset(detail::createDatasetPropertyList(options, rank, dims, sizeof(T)));
+    if(!createPropertyList.isValid())
     {
-      std::cout << "Error Writing Data '" << datasetName << "'" << std::endl;
-      std::cout << "    rank = " << rank << std::endl;
-      uint64_t totalSize = 1;
-      for(size_t i = 0; i < rank; ++i)
-      {
-        std::cout << "    dim[" << i << "] = " << dims[i] << std::endl;
-        totalSize = totalSize * dims[i];
-      }
-      std::cout << "    Total Elements = " << totalSize << std::endl;
-      std::cout << "    Size of Type (Bytes) = " << sizeof(T) << std::endl;
-      std::cout << "    Total Bytes to Write =  " << (sizeof(T) * totalSize) << std::endl;
-      returnError = error;
+      return -1;
     }
-    error = H5Dclose(datasetID);
-    if(error < 0)
+  }
+  // Create the Dataset
+  // This will fail if datasetName contains a "/"!
+  DatasetHandle dataset(H5Dcreate(locationID, datasetName.c_str(), dataType, dataspace.get(), H5P_DEFAULT, createPropertyList.isValid() ? createPropertyList.get() : H5P_DEFAULT, H5P_DEFAULT));
+  if(!dataset.isValid())
+  {
+    return static_cast<herr_t>(dataset.get());
+  }
+  herr_t error = H5Dwrite(dataset.get(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+  if(error < 0)
+  {
+    std::cout << "Error Writing Data '" << datasetName << "'" << std::endl;
+    std::cout << "    rank = " << rank << std::endl;
+    uint64_t totalSize = 1;
+    for(size_t i = 0; i < rank; ++i)
     {
-      std::cout << "Error Closing Dataset." << std::endl;
-      returnError = error;
+      std::cout << "    dim[" << i << "] = " << dims[i] << std::endl;
+      totalSize = totalSize * dims[i];
     }
+    std::cout << "    Total Elements = " << totalSize << std::endl;
+    std::cout << "    Size of Type (Bytes) = " << sizeof(T) << std::endl;
+    std::cout << "    Total Bytes to Write =  " << (sizeof(T) * totalSize) << std::endl;
+    returnError = error;
   }
-  else
+  error = dataset.close();
+  if(error < 0)
   {
-    returnError = static_cast<herr_t>(datasetID);
+    std::cout << "Error Closing Dataset." << std::endl;
+    returnError = error;
   }
   /* Terminate access to the data space. */
-  herr_t error = H5Sclose(dataspaceID);
+  error = dataspace.close();
   if(error < 0)
   {
     std::cout << "Error Closing Dataspace" << std::endl;
@@ -649,17 +889,49 @@ inline herr_t writePointerDataset(hid_t locationID, const std::string& datasetNa
   return returnError;
 }
 
+/**
+ * @brief Writes the data of a pointer to an HDF5 file
+ * @param locationID The hdf5 object id of the parent
+ * @param datasetName The name of the dataset to write to. This can be a name of Path
+ * @param rank The number of dimensions
+ * @param dims The sizes of each dimension
+ * @param data The data to be written.
+ * @return Standard hdf5 error condition.
+ */
+template <typename T>
+inline herr_t writePointerDataset(hid_t locationID, const std::string& datasetName, int32_t rank, const hsize_t* dims, const T* data)
+{
+  return writePointerDataset(locationID, datasetName, rank, dims, data, DatasetCreateOptions());
+}
+
+/**
+ * @brief How replacePointerDataset treats a dataset that already exists
+ */
+enum class ReplaceMode : int32_t
+{
+  InPlace = 0,  ///< Writes into the existing dataset. Its dimensions must match, a different datatype is converted by HDF5.
+  Resize = 1,   ///< Like InPlace, but a chunked dataset whose maximum dimensions allow it is resized with H5Dset_extent
+  Recreate = 2, ///< Like Resize, but a dataset that can not be resized, or that has a different datatype, is unlinked and created again
+};
+
 /**
  * @brief Replaces the given dataset with the data of a pointer to an HDF5 file. Creates the dataset if it does not exist.
+ * An existing dataset is written in place if its dimensions match. What happens otherwise depends on mode; only
+ * ReplaceMode::Recreate unlinks the dataset, which drops its attributes. The replacement is created and written
+ * first and the old dataset is only unlinked once the replacement is linked in its place, so a failed Recreate
+ * leaves the old dataset untouched. The space of an unlinked dataset is reused
+ * by later writes while the file is open, and across opens when the file was created with
+ * FileCreateOptions::setPersistentFreeSpace.
  * @param locationID The hdf5 object id of the parent
  * @param datasetName The name of the dataset to write to. This can be a name of Path
  * @param rank The number of dimensions
  * @param dims The sizes of each dimension
  * @param data The data to be written.
+ * @param mode What to do when the existing dataset has a different shape or type
  * @return Standard hdf5 error condition.
  */
 template <typename T>
-inline herr_t replacePointerDataset(hid_t locationID, const std::string& datasetName, int32_t rank, const hsize_t* dims, const T* data)
+inline herr_t replacePointerDataset(hid_t locationID, const std::string& datasetName, int32_t rank, const hsize_t* dims, const T* data, ReplaceMode mode = ReplaceMode::InPlace)
 {
   H5SUPPORT_MUTEX_LOCK()
 
@@ -676,40 +948,176 @@ inline herr_t replacePointerDataset(hid_t locationID, const std::string& dataset
     return -1;
   }
   // Create the DataSpace
-  hid_t dataspaceID = H5Screate_simple(rank, dims, nullptr);
-  if(dataspaceID < 0)
+  DataspaceHandle dataspace(H5Screate_simple(rank, dims, nullptr));
+  if(!dataspace.isValid())
   {
-    return dataspaceID;
+    return static_cast<herr_t>(dataspace.get());
   }
 
   HDF_ERROR_HANDLER_OFF
-  hid_t datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT);
+  DatasetHandle dataset(H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT));
   HDF_ERROR_HANDLER_ON
-  if(datasetID < 0) // dataset does not exist so create it
-  {
-    datasetID = H5Dcreate(locationID, datasetName.c_str(), dataType, dataspaceID, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-  }
-  if(datasetID >= 0)
+  if(dataset.isValid())
   {
-    herr_t error = H5Dwrite(datasetID, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
-    if(error < 0)
+    // Compare the shape and type on disk with the new data
+    DataspaceHandle fileSpace(H5Dget_space(dataset.get()));
+    int32_t fileRank = fileSpace.isValid() ? H5Sget_simple_extent_ndims(fileSpace.get()) : -1;
+    std::vector<hsize_t> fileDims(static_cast<size_t>(std::max(fileRank, 0)));
+    std::vector<hsize_t> maxDims(fileDims.size());
+    if(fileRank > 0)
     {
-      std::cout << "Error Writing Data" << std::endl;
-      returnError = error;
+      H5Sget_simple_extent_dims(fileSpace.get(), fileDims.data(), maxDims.data());
     }
-    error = H5Dclose(datasetID);
-    if(error < 0)
+    bool sameDims = fileRank == rank && std::equal(fileDims.begin(), fileDims.end(), dims);
+    TypeHandle fileType(H5Dget_type(dataset.get()));
+    bool sameType = fileType.isValid() && H5Tequal(fileType.get(), dataType) > 0;
+
+    bool resized = false;
+    if(!sameDims && mode != ReplaceMode::InPlace && fileRank == rank)
     {
-      std::cout << "Error Closing Dataset." << std::endl;
-      returnError = error;
+      PropertyListHandle createPropertyList(H5Dget_create_plist(dataset.get()));
+      bool fits = createPropertyList.isValid() && H5Pget_layout(createPropertyList.get()) == H5D_CHUNKED;
+      for(int32_t i = 0; fits && i < rank; i++)
+      {
+        fits = maxDims[i] == H5S_UNLIMITED || dims[i] <= maxDims[i];
+      }
+      if(fits && (sameType || mode != ReplaceMode::Recreate))
+      {
+        herr_t error = H5Dset_extent(dataset.get(), dims);
+        if(error < 0)
+        {
+          std::cout << "Error changing the extent of dataset '" << datasetName << "'" << std::endl;
+          return error;
+        }
+        resized = true;
+      }
+    }
+
+    if((!sameDims && !resized) || (!sameType && mode == ReplaceMode::Recreate))
+    {
+      if(mode != ReplaceMode::Recreate)
+      {
+        std::cout << "H5Lite.h::replacePointerDataset(" << __LINE__ << ") The dimensions of dataset '" << datasetName << "' do not match the data and it can not be resized" << std::endl;
+        return -1;
+      }
+      // Keep the creation properties (chunking, filters) when they still fit the new rank. Other
+      // layouts are picked again for the new size since a compact dataset may have outgrown the threshold.
+      PropertyListHandle createPropertyList;
+      if(fileRank == rank)
+      {
+        createPropertyList.reset(H5Dget_create_plist(dataset.get()));
+      }
+      if(!createPropertyList.isValid() || H5Pget_layout(createPropertyList.get()) != H5D_CHUNKED)
+      {
+        createPropertyList.reset();
+        if(detail::useCompactLayout(DatasetCreateOptions(), rank, dims, sizeof(T)))
+        {
+          createPropertyList.reset(detail::createDatasetPropertyList(DatasetCreateOptions(), rank, dims, sizeof(T)));
+        }
+      }
+      if(createPropertyList.isValid() && H5Pget_layout(createPropertyList.get()) == H5D_CHUNKED)
+      {
+        // Dimensions that were unlimited stay unlimited. Chunks may not be larger than a fixed dimension.
+        std::vector<hsize_t> chunkDims(static_cast<size_t>(rank));
+        H5Pget_chunk(createPropertyList.get(), rank, chunkDims.data());
+        for(int32_t i = 0; i < rank; i++)
+        {
+          maxDims[i] = maxDims[i] == H5S_UNLIMITED ? H5S_UNLIMITED : dims[i];
+          if(maxDims[i] != H5S_UNLIMITED)
+          {
+            chunkDims[i] = std::max(std::min(chunkDims[i], dims[i]), static_cast<hsize_t>(1));
+          }
+        }
+        if(H5Pset_chunk(createPropertyList.get(), rank, chunkDims.data()) < 0)
+        {
+          std::cout << "Error setting the chunk dimensions of dataset '" << datasetName << "'" << std::endl;
+          return -1;
+        }
+        dataspace.reset(H5Screate_simple(rank, dims, maxDims.data()));
+      }
+      // Create and write the replacement without a name so the old dataset survives any failure,
+      // then swap the link over to it
+      DatasetHandle replacement(H5Dcreate_anon(locationID, dataType, dataspace.get(), createPropertyList.isValid() ? createPropertyList.get() : H5P_DEFAULT, H5P_DEFAULT));
+      if(!replacement.isValid())
+      {
+        std::cout << "Error creating the replacement of dataset '" << datasetName << "'" << std::endl;
+        return static_cast<herr_t>(replacement.get());
+      }
+      herr_t error = H5Dwrite(replacement.get(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+      if(error < 0)
+      {
+        std::cout << "Error Writing Data" << std::endl;
+        return error;
+      }
+      // Cached chunks only go through the filters when they are flushed
+      error = H5Dflush(replacement.get());
+      if(error < 0)
+      {
+        std::cout << "Error flushing the replacement of dataset '" << datasetName << "'" << std::endl;
+        return error;
+      }
+      dataset.close();
+      H5ObjectCache::invalidate(locationID, datasetName);
+      // Park the old dataset under a temporary name in the same group until the replacement is linked
+      std::string parkedName = datasetName + ".replaced";
+      for(int32_t i = 1; H5Lexists(locationID, parkedName.c_str(), H5P_DEFAULT) > 0; i++)
+      {
+        parkedName = datasetName + ".replaced" + std::to_string(i);
+      }
+      error = H5Lmove(locationID, datasetName.c_str(), locationID, parkedName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+      if(error < 0)
+      {
+        std::cout << "Error unlinking dataset '" << datasetName << "'" << std::endl;
+        return error;
+      }
+      error = H5Olink(replacement.get(), locationID, datasetName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+      if(error < 0)
+      {
+        std::cout << "Error linking the replacement of dataset '" << datasetName << "'" << std::endl;
+        H5Lmove(locationID, parkedName.c_str(), locationID, datasetName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+        return error;
+      }
+      error = H5Ldelete(locationID, parkedName.c_str(), H5P_DEFAULT);
+      if(error < 0)
+      {
+        std::cout << "Error unlinking dataset '" << parkedName << "'" << std::endl;
+        return error;
+      }
+      error = replacement.close();
+      if(error < 0)
+      {
+        std::cout << "Error Closing Dataset." << std::endl;
+      }
+      return error;
     }
   }
-  else
+  else // dataset does not exist so create it
+  {
+    PropertyListHandle createPropertyList;
+    if(detail::useCompactLayout(DatasetCreateOptions(), rank, dims, sizeof(T)))
+    {
+      createPropertyList.reset(detail::createDatasetPropertyList(DatasetCreateOptions(), rank, dims, sizeof(T)));
+    }
+    dataset.reset(H5Dcreate(locationID, datasetName.c_str(), dataType, dataspace.get(), H5P_DEFAULT, createPropertyList.isValid() ? createPropertyList.get() : H5P_DEFAULT, H5P_DEFAULT));
+  }
+  if(!dataset.isValid())
   {
-    returnError = static_cast<herr_t>(datasetID);
+    return static_cast<herr_t>(dataset.get());
+  }
+  herr_t error = H5Dwrite(dataset.get(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+  if(error < 0)
+  {
+    std::cout << "Error Writing Data" << std::endl;
+    returnError = error;
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset." << std::endl;
+    returnError = error;
   }
   /* Terminate access to the data space. */
-  herr_t error = H5Sclose(dataspaceID);
+  error = dataspace.close();
   if(error < 0)
   {
     std::cout << "Error Closing Dataspace" << std::endl;
@@ -751,31 +1159,223 @@ inline herr_t writeVectorDataset(hid_t locationID, const std::string& datasetNam
 }
 
 /**
- * @brief Returns a guess for the vector of chunk dimensions based on the input parameters.
- * @param dims The vector dimensions of the dataset
- * @param typeSize The size of the data type for the dataset
- * @return The vector of chunk dimensions guess
+ * @brief Same as writeVectorDataset, creating the dataset with the given options
+ * @param options The layout, filters, allocation and fill settings of the new dataset
  */
-inline std::vector<hsize_t> guessChunkSize(const std::vector<hsize_t>& dims, size_t typeSize)
+template <typename T>
+inline herr_t writeVectorDataset(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& dims, const std::vector<T>& data, const DatasetCreateOptions& options)
 {
-  std::vector<hsize_t> chunks(dims.cbegin(), dims.cend());
-  size_t chunksSize = chunks.size();
-
-  hsize_t product = std::accumulate(chunks.cbegin(), chunks.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
-  hsize_t datasetSize = product * typeSize;
-  double percentage = std::pow(2.0, std::log10(static_cast<double>(datasetSize) / (1024.0 * 1024.0)));
-  hsize_t targetSize = static_cast<hsize_t>(static_cast<double>(detail::k_ChunkBase) * percentage);
-  targetSize = std::clamp(targetSize, static_cast<hsize_t>(detail::k_ChunkMin), static_cast<hsize_t>(detail::k_ChunkMax));
-
-  size_t index = 0;
-
-  bool foundChunkSize = false;
+  return writePointerDataset(locationID, datasetName, static_cast<int32_t>(dims.size()), dims.data(), data.data(), options);
+}
 
-  while(!foundChunkSize)
-  {
-    product = std::accumulate(chunks.cbegin(), chunks.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
-    hsize_t chunkBytes = product * typeSize;
-    if(chunkBytes < targetSize)
+namespace detail
+{
+/**
+ * @brief Selects a hyperslab in the file dataspace of an open dataset and creates
+ * the matching memory dataspace.
+ * @param datasetID The open dataset
+ * @param rank The number of elements in start, stride, count and block. It must match the rank of the
+ * dataset. A negative value takes the rank of the dataset for callers that can not know it.
+ * @param start The offset of the starting element in each dimension
+ * @param stride The number of elements to move in each dimension. May be nullptr (stride of 1)
+ * @param count The number of blocks to select in each dimension
+ * @param block The size of a block in each dimension. May be nullptr (block of 1)
+ * @param fileSpace (out) The file dataspace with the hyperslab selected
+ * @param memSpace (out) The memory dataspace that holds the selected elements contiguously
+ * @return Standard HDF5 error condition
+ */
+inline herr_t createHyperslabDataspaces(hid_t datasetID, int32_t rank, const hsize_t* start, const hsize_t* stride, const hsize_t* count, const hsize_t* block,
+                                        DataspaceHandle& fileSpace, DataspaceHandle& memSpace)
+{
+  fileSpace.reset(H5Dget_space(datasetID));
+  if(!fileSpace.isValid())
+  {
+    std::cout << "Error getting the dataspace of the dataset" << std::endl;
+    return -1;
+  }
+  int32_t fileRank = H5Sget_simple_extent_ndims(fileSpace.get());
+  if(fileRank <= 0)
+  {
+    std::cout << "Hyperslab selections require a dataset with a rank of at least 1" << std::endl;
+    return -1;
+  }
+  if(rank >= 0 && rank != fileRank)
+  {
+    std::cout << "The hyperslab has " << rank << " dimensions but the dataset has " << fileRank << std::endl;
+    return -5;
+  }
+  rank = fileRank;
+  herr_t error = H5Sselect_hyperslab(fileSpace.get(), H5S_SELECT_SET, start, stride, count, block);
+  if(error < 0 || H5Sselect_valid(fileSpace.get()) <= 0)
+  {
+    std::cout << "Error selecting the hyperslab. The selection is not within the extent of the dataset" << std::endl;
+    return -1;
+  }
+  std::vector<hsize_t> memDims(count, count + rank);
+  if(nullptr != block)
+  {
+    for(int32_t i = 0; i < rank; i++)
+    {
+      memDims[i] *= block[i];
+    }
+  }
+  memSpace.reset(H5Screate_simple(rank, memDims.data(), nullptr));
+  if(!memSpace.isValid())
+  {
+    std::cout << "Error creating the memory dataspace for the hyperslab" << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Returns the number of elements a hyperslab selection will hold in memory
+ */
+inline hsize_t getHyperslabNumElements(const std::vector<hsize_t>& count, const std::vector<hsize_t>& block)
+{
+  hsize_t numElements = std::accumulate(count.cbegin(), count.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+  return std::accumulate(block.cbegin(), block.cend(), numElements, std::multiplies<hsize_t>());
+}
+} // namespace detail
+
+/**
+ * @brief Writes the data of a pointer into a hyperslab of an existing dataset. The
+ * data is expected to be packed in memory, i.e. it holds count[i] * block[i]
+ * elements in each dimension.
+ * @param locationID The hdf5 object id of the parent
+ * @param datasetName The name of the existing dataset to write to
+ * @param rank The number of elements in start, stride, count and block. Must match the rank of the dataset.
+ * @param start The offset of the starting element in each dimension
+ * @param stride The number of elements to move in each dimension. May be nullptr
+ * @param count The number of blocks to write in each dimension
+ * @param block The size of a block in each dimension. May be nullptr
+ * @param data The data to be written.
+ * @return Standard hdf5 error condition.
+ */
+template <typename T>
+inline herr_t writePointerHyperslab(hid_t locationID, const std::string& datasetName, int32_t rank, const hsize_t* start, const hsize_t* stride, const hsize_t* count, const hsize_t* block,
+                                    const T* data)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t returnError = 0;
+  if(nullptr == data || nullptr == start || nullptr == count)
+  {
+    return -2;
+  }
+  hid_t dataType = HDFTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return -1;
+  }
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
+  {
+    std::cout << "H5Lite.h::writePointerHyperslab(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    return -1;
+  }
+  DataspaceHandle fileSpace;
+  DataspaceHandle memSpace;
+  herr_t error = detail::createHyperslabDataspaces(dataset.get(), rank, start, stride, count, block, fileSpace, memSpace);
+  if(error < 0)
+  {
+    return error;
+  }
+  error = H5Dwrite(dataset.get(), dataType, memSpace.get(), fileSpace.get(), H5P_DEFAULT, data);
+  if(error < 0)
+  {
+    std::cout << "Error Writing Hyperslab to '" << datasetName << "'" << std::endl;
+    returnError = error;
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+
+/**
+ * @brief Writes the data of a pointer into a hyperslab of an existing dataset. start, stride, count
+ * and block must hold as many elements as the dataset has dimensions since they can not be checked.
+ * Prefer the overload that takes the rank.
+ */
+template <typename T>
+inline herr_t writePointerHyperslab(hid_t locationID, const std::string& datasetName, const hsize_t* start, const hsize_t* stride, const hsize_t* count, const hsize_t* block, const T* data)
+{
+  return writePointerHyperslab(locationID, datasetName, -1, start, stride, count, block, data);
+}
+
+/**
+ * @brief Writes a std::vector into a hyperslab of an existing dataset.
+ * @param locationID The hdf5 object id of the parent
+ * @param datasetName The name of the existing dataset to write to
+ * @param start The offset of the starting element in each dimension
+ * @param stride The number of elements to move in each dimension. Empty for a stride of 1
+ * @param count The number of blocks to write in each dimension
+ * @param block The size of a block in each dimension. Empty for a block of 1
+ * @param data The data to be written. Must hold the number of elements that are selected.
+ * @return Standard hdf5 error condition.
+ */
+template <typename T>
+inline herr_t writeVectorHyperslab(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& start, const std::vector<hsize_t>& stride, const std::vector<hsize_t>& count,
+                                   const std::vector<hsize_t>& block, const std::vector<T>& data)
+{
+  if(start.size() != count.size() || (!stride.empty() && stride.size() != start.size()) || (!block.empty() && block.size() != start.size()))
+  {
+    std::cout << "H5Lite.h::writeVectorHyperslab(" << __LINE__ << ") The start, stride, count and block vectors must have the same size" << std::endl;
+    return -3;
+  }
+  if(data.size() < detail::getHyperslabNumElements(count, block))
+  {
+    std::cout << "H5Lite.h::writeVectorHyperslab(" << __LINE__ << ") The data vector is smaller than the selected hyperslab" << std::endl;
+    return -4;
+  }
+  return writePointerHyperslab(locationID, datasetName, static_cast<int32_t>(start.size()), start.data(), stride.empty() ? nullptr : stride.data(), count.data(), block.empty() ? nullptr : block.data(), data.data());
+}
+
+/**
+ * @brief Writes a std::vector into a contiguous hyperslab (stride and block of 1) of an existing dataset.
+ * @param locationID The hdf5 object id of the parent
+ * @param datasetName The name of the existing dataset to write to
+ * @param start The offset of the starting element in each dimension
+ * @param count The number of elements to write in each dimension
+ * @param data The data to be written.
+ * @return Standard hdf5 error condition.
+ */
+template <typename T>
+inline herr_t writeVectorHyperslab(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, const std::vector<T>& data)
+{
+  return writeVectorHyperslab(locationID, datasetName, start, {}, count, {}, data);
+}
+
+/**
+ * @brief Returns a guess for the vector of chunk dimensions based on the input parameters.
+ * @param dims The vector dimensions of the dataset
+ * @param typeSize The size of the data type for the dataset
+ * @return The vector of chunk dimensions guess
+ */
+inline std::vector<hsize_t> guessChunkSize(const std::vector<hsize_t>& dims, size_t typeSize)
+{
+  std::vector<hsize_t> chunks(dims.cbegin(), dims.cend());
+  size_t chunksSize = chunks.size();
+
+  hsize_t product = std::accumulate(chunks.cbegin(), chunks.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+  hsize_t datasetSize = product * typeSize;
+  double percentage = std::pow(2.0, std::log10(static_cast<double>(datasetSize) / (1024.0 * 1024.0)));
+  hsize_t targetSize = static_cast<hsize_t>(static_cast<double>(detail::k_ChunkBase) * percentage);
+  targetSize = std::clamp(targetSize, static_cast<hsize_t>(detail::k_ChunkMin), static_cast<hsize_t>(detail::k_ChunkMax));
+
+  size_t index = 0;
+
+  bool foundChunkSize = false;
+
+  while(!foundChunkSize)
+  {
+    product = std::accumulate(chunks.cbegin(), chunks.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+    hsize_t chunkBytes = product * typeSize;
+    if(chunkBytes < targetSize)
     {
       break;
     }
@@ -850,90 +1450,61 @@ inline herr_t writePointerDatasetCompressed(hid_t locationID, const std::string&
 
   // Create the DataSpace
 
-  hid_t dataspaceID = H5Screate_simple(rank, dims, nullptr);
-  if(dataspaceID < 0)
+  DataspaceHandle dataspace(H5Screate_simple(rank, dims, nullptr));
+  if(!dataspace.isValid())
   {
     return -102;
   }
 
   // Create property list for chunking and compression
 
-  hid_t propertListID = H5Pcreate(H5P_DATASET_CREATE);
-  if(propertListID < 0)
+  PropertyListHandle propertyList(H5Pcreate(H5P_DATASET_CREATE));
+  if(!propertyList.isValid())
   {
-    returnError = -103;
-    error = H5Sclose(dataspaceID);
-    if(error < 0)
-    {
-      returnError = -104;
-    }
-    return returnError;
+    return -103;
   }
 
-  error = H5Pset_chunk(propertListID, cRank, cDims);
+  error = H5Pset_chunk(propertyList.get(), cRank, cDims);
   if(error < 0)
   {
-    error = H5Pclose(propertListID);
-    if(error < 0)
-    {
-      returnError = -105;
-    }
-    error = H5Sclose(dataspaceID);
-    if(error < 0)
-    {
-      returnError = -106;
-    }
-    return returnError;
+    return -105;
   }
 
-  error = H5Pset_deflate(propertListID, compressionLevel);
+  error = H5Pset_deflate(propertyList.get(), compressionLevel);
   if(error < 0)
   {
-    error = H5Pclose(propertListID);
-    if(error < 0)
-    {
-      returnError = -107;
-    }
-    error = H5Sclose(dataspaceID);
-    if(error < 0)
-    {
-      returnError = -108;
-    }
-    return returnError;
+    return -107;
   }
 
   // Create the Dataset
 
-  hid_t datasetID = H5Dcreate(locationID, datasetName.c_str(), dataType, dataspaceID, H5P_DEFAULT, propertListID, H5P_DEFAULT);
-  if(datasetID >= 0)
+  DatasetHandle dataset(H5Dcreate(locationID, datasetName.c_str(), dataType, dataspace.get(), H5P_DEFAULT, propertyList.get(), H5P_DEFAULT));
+  if(!dataset.isValid())
   {
-    error = H5Dwrite(datasetID, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
-    if(error < 0)
-    {
-      std::cout << "Error Writing Data" << std::endl;
-      returnError = -108;
-    }
-    error = H5Dclose(datasetID);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Dataset." << std::endl;
-      returnError = -110;
-    }
+    return -111;
   }
-  else
+  error = H5Dwrite(dataset.get(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+  if(error < 0)
+  {
+    std::cout << "Error Writing Data" << std::endl;
+    returnError = -108;
+  }
+  error = dataset.close();
+  if(error < 0)
   {
-    returnError = -111;
+    std::cout << "Error Closing Dataset." << std::endl;
+    returnError = -110;
   }
 
   // Terminate access to the data space and property list.
 
-  error = H5Pclose(propertListID);
+  error = propertyList.close();
   if(error < 0)
   {
     std::cout << "Error Closing Property List" << std::endl;
     returnError = -112;
   }
-  error = H5Sclose(dataspaceID);
+  error = dataspace.close();
   if(error < 0)
   {
     std::cout << "Error Closing Dataspace" << std::endl;
@@ -962,279 +1533,823 @@ inline herr_t writeVectorDatasetCompressed(hid_t locationID, const std::string&
 }
 #endif
 
+#ifdef H5Support_HAVE_PARALLEL_DEFLATE
+namespace detail
+{
 /**
- * @brief Creates a Dataset with the given name at the location defined by locationID from a std::array
- *
- * @param locationID The Parent location to store the data
- * @param datasetName The name of the dataset
- * @param dims The dimensions of the dataset
- * @param data The data to write to the file
- * @return Standard HDF5 error conditions
+ * @brief Returns the number of threads to use for a parallel operation. A value of 0 means "use every hardware thread".
+ * @param numThreads The requested number of threads
+ * @return The number of threads to use (always at least 1)
  */
-template <typename T, size_t _Size>
-inline herr_t writeArrayDataset(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& dims, const std::array<T, _Size>& data)
+inline size_t getNumberOfThreads(size_t numThreads)
 {
-  return writePointerDataset(locationID, datasetName, static_cast<int32_t>(dims.size()), dims.data(), data.data());
+  if(numThreads == 0)
+  {
+    numThreads = static_cast<size_t>(std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(numThreads, 1);
 }
 
 /**
- * @brief Creates a Dataset with the given name at the location defined by locationID.
- * This version of writeDataset should be used with a single scalar value. If you
- * need to write an array of values, use the form that takes an std::vector<>
- *
- * @param locationID The Parent location to store the data
- * @param datasetName The name of the dataset
- * @param value The value to write to the HDF5 dataset
- * @return Standard HDF5 error conditions
+ * @brief Calls func(index) for every index in [0, count), spreading the calls over numThreads threads.
+ * The calling thread takes part in the work. func must not touch the HDF5 library.
+ * @param numThreads The number of threads to use
+ * @param count The number of work items
+ * @param func The work item callback
  */
-template <typename T>
-inline herr_t writeScalarDataset(hid_t locationID, const std::string& datasetName, const T& value)
+template <typename Func>
+inline void parallelFor(size_t numThreads, size_t count, Func&& func)
 {
-  H5SUPPORT_MUTEX_LOCK()
-
-  herr_t returnError = 0;
-  hsize_t dims = 1;
-  hid_t rank = 1;
-  hid_t dataType = HDFTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    return -1;
-  }
-  // Create the DataSpace
-  hid_t dataspaceID = H5Screate_simple(static_cast<int>(rank), &(dims), nullptr);
-  if(dataspaceID < 0)
+  numThreads = std::min(numThreads, count);
+  if(numThreads <= 1)
   {
-    return static_cast<herr_t>(dataspaceID);
-  }
-  // Create the Dataset
-  hid_t datasetID = H5Dcreate(locationID, datasetName.c_str(), dataType, dataspaceID, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-  if(datasetID >= 0)
-  {
-    herr_t error = H5Dwrite(datasetID, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, &value);
-    if(error < 0)
+    for(size_t i = 0; i < count; i++)
     {
-      std::cout << "Error Writing Data" << std::endl;
-      returnError = error;
+      func(i);
     }
-    error = H5Dclose(datasetID);
-    if(error < 0)
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for(size_t i = next++; i < count; i = next++)
     {
-      std::cout << "Error Closing Dataset." << std::endl;
-      returnError = error;
+      func(i);
     }
-  }
-  else
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads - 1);
+  for(size_t t = 1; t < numThreads; t++)
   {
-    returnError = static_cast<herr_t>(datasetID);
+    threads.emplace_back(worker);
   }
-  /* Terminate access to the data space. */
-  herr_t error = H5Sclose(dataspaceID);
-  if(error < 0)
+  worker();
+  for(auto& thread : threads)
   {
-    std::cout << "Error Closing Dataspace" << std::endl;
-    returnError = error;
+    thread.join();
   }
-  return returnError;
 }
 
 /**
- * @brief Writes a std::string as a HDF Dataset.
- * @param locationID The Parent location to write the dataset
- * @param datasetName The Name to use for the dataset
- * @param data The actual data to write as a null terminated string
- * @return Standard HDF5 error conditions
+ * @brief Returns the number of chunks along each dimension of a dataset
+ * @param dims The dimensions of the dataset
+ * @param cDims The chunk dimensions
+ * @return The chunk grid dimensions
  */
-inline herr_t writeStringDataset(hid_t locationID, const std::string& datasetName, const std::string& data)
+inline std::vector<hsize_t> getChunkGrid(const std::vector<hsize_t>& dims, const std::vector<hsize_t>& cDims)
 {
-  H5SUPPORT_MUTEX_LOCK()
-
-  herr_t returnError = 0;
-  hid_t typeID = H5Tcopy(H5T_C_S1);
-
-  /* create a string data type */
-  if(typeID >= 0)
+  std::vector<hsize_t> grid(dims.size(), 0);
+  for(size_t i = 0; i < dims.size(); i++)
   {
-    size_t size = data.size() + 1;
-    if(H5Tset_size(typeID, size) >= 0)
-    {
-      if(H5Tset_strpad(typeID, H5T_STR_NULLTERM) >= 0)
-      {
-        /* Create the data space for the dataset. */
-        hid_t dataspaceID = H5Screate(H5S_SCALAR);
-        if(dataspaceID >= 0)
-        {
-          /* Create or open the dataset. */
-          HDF_ERROR_HANDLER_OFF
-          hid_t datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT);
-          HDF_ERROR_HANDLER_ON
-          if(datasetID < 0) // dataset does not exist so create it
-          {
-            datasetID = H5Dcreate(locationID, datasetName.c_str(), typeID, dataspaceID, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-          }
-
-          if(datasetID >= 0)
-          {
-            if(!data.empty())
-            {
-              herr_t error = H5Dwrite(datasetID, typeID, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.c_str());
-              if(error < 0)
-              {
-                std::cout << "Error Writing String Data" << std::endl;
-                returnError = error;
-              }
-            }
-          }
-          else
-          {
-            // returnError = datasetID;
-            returnError = 0;
-          }
-          CloseH5D(datasetID, error, returnError, datasetName);
-          //          error = H5Dclose(datasetID);
-          //          if (error < 0) {
-          //            std::cout << "Error Closing Dataset." << std::endl;
-          //            returnError = error;
-          //          }
-        }
-        CloseH5S(dataspaceID, error, returnError);
-        //        error = H5Sclose(dataspaceID);
-        //        if ( error < 0) {
-        //          std::cout << "Error closing Dataspace." << std::endl;
-        //          returnError = error;
-        //        }
-      }
-    }
-    CloseH5T(typeID, error, returnError);
-    //    error = H5Tclose(typeID);
-    //    if (error < 0 ) {
-    //     std::cout << "Error closing DataType" << std::endl;
-    //     returnError = error;
-    //    }
+    grid[i] = (dims[i] + cDims[i] - 1) / cDims[i];
   }
-  return returnError;
+  return grid;
 }
 
 /**
- * @brief Writes a null terminated 'C String' to an HDF Dataset.
- * @param locationID The Parent location to write the dataset
- * @param datasetName The Name to use for the dataset
- * @param size The number of characters in the string
- * @param data const char pointer to write as a null terminated string
- * @return Standard HDF5 error conditions
+ * @brief Computes the element offset of the chunk with the given linear (row major) index in the chunk grid
+ * @param grid The chunk grid dimensions
+ * @param cDims The chunk dimensions
+ * @param chunkIndex The linear index of the chunk
+ * @param offset Receives the element offset of the chunk
  */
-inline herr_t writeStringDataset(hid_t locationID, const std::string& datasetName, size_t size, const char* data)
+inline void getChunkOffset(const std::vector<hsize_t>& grid, const std::vector<hsize_t>& cDims, hsize_t chunkIndex, hsize_t* offset)
 {
-  H5SUPPORT_MUTEX_LOCK()
-
-  hid_t datasetID = -1;
-  hid_t dataspaceID = -1;
-  hid_t typeID = -1;
-  herr_t error = -1;
-  herr_t returnError = 0;
-
-  /* create a string data type */
-  if((typeID = H5Tcopy(H5T_C_S1)) >= 0)
+  for(size_t i = grid.size(); i > 0; i--)
   {
-    if(H5Tset_size(typeID, size) >= 0)
-    {
-      if(H5Tset_strpad(typeID, H5T_STR_NULLTERM) >= 0)
-      {
-        /* Create the data space for the dataset. */
-        if((dataspaceID = H5Screate(H5S_SCALAR)) >= 0)
-        {
-          /* Create the dataset. */
-          if((datasetID = H5Dcreate(locationID, datasetName.c_str(), typeID, dataspaceID, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) >= 0)
-          {
-            if(nullptr != data)
-            {
-              error = H5Dwrite(datasetID, typeID, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
-              if(error < 0)
-              {
-                std::cout << "Error Writing String Data" << std::endl;
-                returnError = error;
-              }
-            }
-          }
-          else
-          {
-            // returnError = datasetID;
-            returnError = 0;
-          }
-          CloseH5D(datasetID, error, returnError, datasetName);
-        }
-        CloseH5S(dataspaceID, error, returnError);
-      }
-    }
-    CloseH5T(typeID, error, returnError);
+    offset[i - 1] = (chunkIndex % grid[i - 1]) * cDims[i - 1];
+    chunkIndex /= grid[i - 1];
   }
-  return returnError;
 }
 
 /**
- * @brief Writes a vector of null terminated strings to an HDF dataset.
- * @param locationID
- * @param datasetName
- * @param size
- * @param data
- * @return
+ * @brief Copies the part of a row major array covered by a chunk between the array and a dense chunk buffer.
+ * Chunks that hang over the edge of the array only copy the part that lies inside the array; the rest of the
+ * chunk buffer is left untouched.
+ * @param dims The dimensions of the array
+ * @param cDims The chunk dimensions
+ * @param offset The element offset of the chunk
+ * @param typeSize The size of one element in bytes
+ * @param array The array
+ * @param chunk The chunk buffer (product of cDims * typeSize bytes)
+ * @param toChunk True to copy from the array into the chunk, false to copy from the chunk into the array
  */
-inline herr_t writeVectorOfStringsDataset(hid_t locationID, const std::string& datasetName, const std::vector<std::string>& data)
+inline void copyChunk(const std::vector<hsize_t>& dims, const std::vector<hsize_t>& cDims, const hsize_t* offset, size_t typeSize, uint8_t* array, uint8_t* chunk, bool toChunk)
+{
+  const size_t rank = dims.size();
+  std::vector<hsize_t> extent(rank, 0);
+  for(size_t i = 0; i < rank; i++)
+  {
+    extent[i] = std::min(cDims[i], dims[i] - offset[i]);
+  }
+  const size_t rowBytes = static_cast<size_t>(extent[rank - 1]) * typeSize;
+
+  // Walk every row of the chunk that lies inside the array
+  std::vector<hsize_t> pos(rank, 0);
+  while(true)
+  {
+    size_t arrayIndex = 0;
+    size_t chunkIndex = 0;
+    for(size_t i = 0; i < rank; i++)
+    {
+      arrayIndex = arrayIndex * static_cast<size_t>(dims[i]) + static_cast<size_t>(offset[i] + pos[i]);
+      chunkIndex = chunkIndex * static_cast<size_t>(cDims[i]) + static_cast<size_t>(pos[i]);
+    }
+    if(toChunk)
+    {
+      std::memcpy(chunk + chunkIndex * typeSize, array + arrayIndex * typeSize, rowBytes);
+    }
+    else
+    {
+      std::memcpy(array + arrayIndex * typeSize, chunk + chunkIndex * typeSize, rowBytes);
+    }
+
+    // Advance to the next row, odometer style, over every dimension but the last
+    size_t dim = rank - 1;
+    while(true)
+    {
+      if(dim == 0)
+      {
+        return;
+      }
+      dim--;
+      if(++pos[dim] < extent[dim])
+      {
+        break;
+      }
+      pos[dim] = 0;
+    }
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Creates a chunked, deflate compressed Dataset and writes the data to it. The chunks are compressed
+ * with zlib on a pool of threads and then handed to HDF5 with H5Dwrite_chunk so the filter pipeline is
+ * bypassed. Chunks that deflate can not shrink are stored uncompressed with the filter flagged as skipped in
+ * their filter mask. Every other chunk is byte for byte what writePointerDatasetCompressed stores, and any
+ * HDF5 reader can read the file.
+ *
+ * @param locationID The Parent location to store the data
+ * @param datasetName The name of the dataset
+ * @param rank The number of dimensions
+ * @param dims The dimensions of the dataset
+ * @param data The data to write to the file
+ * @param cRank The number of dimensions for cDims (must equal rank)
+ * @param cDims The chunk dimensions
+ * @param compressionLevel The compression level (0-9)
+ * @param numThreads The number of compression threads. 0 uses every hardware thread.
+ * @return Standard HDF5 error conditions
+ */
+template <typename T>
+inline herr_t writePointerDatasetCompressedParallel(hid_t locationID, const std::string& datasetName, int32_t rank, const hsize_t* dims, const T* data, int32_t cRank, const hsize_t* cDims,
+                                                    int32_t compressionLevel, size_t numThreads = 0)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t dataspaceID = -1;
-  hid_t memSpace = -1;
-  hid_t datatype = -1;
-  hid_t datasetID = -1;
   herr_t error = -1;
   herr_t returnError = 0;
 
-  std::array<hsize_t, 1> dims = {data.size()};
-  if((dataspaceID = H5Screate_simple(static_cast<int>(dims.size()), dims.data(), nullptr)) >= 0)
+  if(data == nullptr)
   {
-    dims[0] = 1;
+    return -100;
+  }
 
-    if((memSpace = H5Screate_simple(static_cast<int>(dims.size()), dims.data(), nullptr)) >= 0)
-    {
+  hid_t dataType = HDFTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return -101;
+  }
+
+  if(rank <= 0 || cRank != rank)
+  {
+    std::cout << "H5Lite.h::writePointerDatasetCompressedParallel(" << __LINE__ << ") The chunk rank must match the dataset rank" << std::endl;
+    return -114;
+  }
+  compressionLevel = std::min(std::max(compressionLevel, 0), 9);
+
+  DataspaceHandle dataspace(H5Screate_simple(rank, dims, nullptr));
+  if(!dataspace.isValid())
+  {
+    return -102;
+  }
+
+  PropertyListHandle propertyList(H5Pcreate(H5P_DATASET_CREATE));
+  if(!propertyList.isValid())
+  {
+    return -103;
+  }
+
+  if(H5Pset_chunk(propertyList.get(), cRank, cDims) < 0 || H5Pset_deflate(propertyList.get(), static_cast<uint32_t>(compressionLevel)) < 0)
+  {
+    return -105;
+  }
+
+  DatasetHandle dataset(H5Dcreate(locationID, datasetName.c_str(), dataType, dataspace.get(), H5P_DEFAULT, propertyList.get(), H5P_DEFAULT));
+  if(!dataset.isValid())
+  {
+    return -111;
+  }
+
+  const std::vector<hsize_t> vDims(dims, dims + rank);
+  const std::vector<hsize_t> vChunkDims(cDims, cDims + rank);
+  const std::vector<hsize_t> grid = detail::getChunkGrid(vDims, vChunkDims);
+  const hsize_t numChunks = std::accumulate(grid.begin(), grid.end(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+  const size_t chunkBytes = std::accumulate(vChunkDims.begin(), vChunkDims.end(), sizeof(T), std::multiplies<size_t>());
 
-      datatype = H5Tcopy(H5T_C_S1);
-      H5Tset_size(datatype, H5T_VARIABLE);
+  // Chunks are compressed in batches so the memory held at once stays bounded. The buffers are allocated
+  // here, once, so the workers never allocate and an allocation failure can not escape a worker thread.
+  numThreads = detail::getNumberOfThreads(numThreads);
+  const size_t batchSize = numThreads * 4;
+  const uLong compressedBound = compressBound(static_cast<uLong>(chunkBytes));
+  std::vector<std::vector<uint8_t>> rawChunks(batchSize, std::vector<uint8_t>(chunkBytes));
+  std::vector<std::vector<uint8_t>> compressedChunks(batchSize, std::vector<uint8_t>(compressedBound));
+  std::vector<uLongf> compressedSizes(batchSize, 0);
+  std::vector<int> zlibErrors(batchSize, Z_OK);
+  std::vector<hsize_t> offsets(batchSize * rank, 0);
+  uint8_t* array = reinterpret_cast<uint8_t*>(const_cast<T*>(data));
+
+  for(hsize_t batchStart = 0; batchStart < numChunks && returnError >= 0; batchStart += batchSize)
+  {
+    const size_t count = static_cast<size_t>(std::min<hsize_t>(batchSize, numChunks - batchStart));
+    detail::parallelFor(numThreads, count, [&](size_t i) {
+      hsize_t* offset = offsets.data() + i * rank;
+      detail::getChunkOffset(grid, vChunkDims, batchStart + i, offset);
+      // Edge chunks are zero padded just like the HDF5 library does
+      std::fill(rawChunks[i].begin(), rawChunks[i].end(), static_cast<uint8_t>(0));
+      detail::copyChunk(vDims, vChunkDims, offset, sizeof(T), array, rawChunks[i].data(), true);
+      compressedSizes[i] = compressedBound;
+      zlibErrors[i] = compress2(compressedChunks[i].data(), &compressedSizes[i], rawChunks[i].data(), static_cast<uLong>(chunkBytes), compressionLevel);
+    });
 
-      if((datasetID = H5Dcreate(locationID, datasetName.c_str(), datatype, dataspaceID, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) >= 0)
+    for(size_t i = 0; i < count; i++)
+    {
+      if(zlibErrors[i] != Z_OK)
       {
-        // Select the "memory" to be written out - just 1 record.
-        hsize_t dataset_offset[] = {0};
-        hsize_t dataset_count[] = {1};
-        H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, dataset_offset, nullptr, dataset_count, nullptr);
-        hsize_t pos = 0;
-        for(const auto& element : data)
-        {
-          // Select the file position, 1 record at position 'pos'
-          hsize_t element_count[] = {1};
-          hsize_t element_offset[] = {pos};
-          pos++;
-          H5Sselect_hyperslab(dataspaceID, H5S_SELECT_SET, element_offset, nullptr, element_count, nullptr);
-          const char* strPtr = element.c_str();
-          error = H5Dwrite(datasetID, datatype, memSpace, dataspaceID, H5P_DEFAULT, &strPtr);
-          if(error < 0)
-          {
-            std::cout << "Error Writing String Data: " __FILE__ << "(" << __LINE__ << ")" << std::endl;
-            returnError = error;
-          }
-        }
-        CloseH5D(datasetID, error, returnError, datasetName);
+        std::cout << "H5Lite.h::writePointerDatasetCompressedParallel(" << __LINE__ << ") zlib error " << zlibErrors[i] << " compressing a chunk" << std::endl;
+        returnError = -115;
+        break;
+      }
+      // A chunk that does not shrink is stored as is, with the deflate filter flagged as skipped
+      if(compressedSizes[i] >= chunkBytes)
+      {
+        error = H5Dwrite_chunk(dataset.get(), H5P_DEFAULT, 0x1, offsets.data() + i * rank, chunkBytes, rawChunks[i].data());
+      }
+      else
+      {
+        error = H5Dwrite_chunk(dataset.get(), H5P_DEFAULT, 0, offsets.data() + i * rank, compressedSizes[i], compressedChunks[i].data());
+      }
+      if(error < 0)
+      {
+        std::cout << "Error Writing Data" << std::endl;
+        returnError = -108;
+        break;
       }
-      H5Tclose(datatype);
-      CloseH5S(memSpace, error, returnError);
     }
-
-    CloseH5S(dataspaceID, error, returnError);
+  }
+
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset." << std::endl;
+    returnError = -110;
+  }
+  return returnError;
+}
+
+/**
+ * @brief Creates a chunked, deflate compressed Dataset, compressing the chunks on a pool of threads.
+ * See writePointerDatasetCompressedParallel.
+ *
+ * @param locationID The Parent location to store the data
+ * @param datasetName The name of the dataset
+ * @param dims The dimensions of the dataset
+ * @param data The data to write to the file
+ * @param cDims The chunk dimensions
+ * @param compressionLevel The compression level (0-9)
+ * @param numThreads The number of compression threads. 0 uses every hardware thread.
+ * @return Standard HDF5 error conditions
+ */
+template <typename T>
+inline herr_t writeVectorDatasetCompressedParallel(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& dims, const std::vector<T>& data, const std::vector<hsize_t>& cDims,
+                                                   int32_t compressionLevel, size_t numThreads = 0)
+{
+  return writePointerDatasetCompressedParallel(locationID, datasetName, static_cast<int32_t>(dims.size()), dims.data(), data.data(), static_cast<int32_t>(cDims.size()), cDims.data(),
+                                               compressionLevel, numThreads);
+}
+#endif
+
+/**
+ * @brief Creates an empty, chunked dataset that can grow without bounds along its
+ * first dimension. Each entry along the first dimension is a "frame" with the
+ * dimensions given by frameDims. Frames are added with appendPointerDataset or
+ * appendVectorDataset, so long acquisitions can be written as they arrive instead
+ * of being buffered in memory.
+ *
+ * @param locationID The Parent location to store the data
+ * @param datasetName The name of the dataset
+ * @param frameDims The dimensions of a single frame. Empty for a stream of scalar values
+ * @param framesPerChunk The number of frames stored in each chunk. Zero picks a value that keeps chunks near 1 MB
+ * @param compressionLevel The deflate compression level (1-9). Values less than 1 disable compression
+ * @return Standard HDF5 error conditions
+ */
+template <typename T>
+inline herr_t createExtendibleDataset(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& frameDims, hsize_t framesPerChunk = 0, int32_t compressionLevel = 0)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t error = 0;
+  herr_t returnError = 0;
+
+  hid_t dataType = HDFTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return -1;
+  }
+
+  hsize_t frameElements = std::accumulate(frameDims.cbegin(), frameDims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+  if(frameElements == 0)
+  {
+    std::cout << "H5Lite.h::createExtendibleDataset(" << __LINE__ << ") The frame dimensions must not contain a zero" << std::endl;
+    return -2;
+  }
+  if(framesPerChunk == 0)
+  {
+    hsize_t frameBytes = frameElements * sizeof(T);
+    framesPerChunk = std::max(static_cast<hsize_t>(1), static_cast<hsize_t>(detail::k_ChunkMax) / frameBytes);
+  }
+
+  std::vector<hsize_t> dims(frameDims.size() + 1, 0);
+  std::vector<hsize_t> maxDims(frameDims.size() + 1, H5S_UNLIMITED);
+  std::vector<hsize_t> chunkDims(frameDims.size() + 1, framesPerChunk);
+  std::copy(frameDims.cbegin(), frameDims.cend(), dims.begin() + 1);
+  std::copy(frameDims.cbegin(), frameDims.cend(), maxDims.begin() + 1);
+  std::copy(frameDims.cbegin(), frameDims.cend(), chunkDims.begin() + 1);
+
+  DataspaceHandle dataspace(H5Screate_simple(static_cast<int>(dims.size()), dims.data(), maxDims.data()));
+  if(!dataspace.isValid())
+  {
+    return static_cast<herr_t>(dataspace.get());
+  }
+
+  PropertyListHandle propertyList(H5Pcreate(H5P_DATASET_CREATE));
+  if(!propertyList.isValid())
+  {
+    return static_cast<herr_t>(propertyList.get());
+  }
+  error = H5Pset_chunk(propertyList.get(), static_cast<int>(chunkDims.size()), chunkDims.data());
+#ifdef H5_HAVE_FILTER_DEFLATE
+  if(error >= 0 && compressionLevel > 0)
+  {
+    error = H5Pset_deflate(propertyList.get(), static_cast<uint32_t>(compressionLevel));
+  }
+#endif
+  if(error < 0)
+  {
+    std::cout << "H5Lite.h::createExtendibleDataset(" << __LINE__ << ") Error setting the chunking/compression properties" << std::endl;
+    return error;
+  }
+
+  DatasetHandle dataset(H5Dcreate(locationID, datasetName.c_str(), dataType, dataspace.get(), H5P_DEFAULT, propertyList.get(), H5P_DEFAULT));
+  if(!dataset.isValid())
+  {
+    std::cout << "H5Lite.h::createExtendibleDataset(" << __LINE__ << ") Error creating Dataset '" << datasetName << "'" << std::endl;
+    return static_cast<herr_t>(dataset.get());
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+
+/**
+ * @brief Appends frames to the end of a dataset that was created with createExtendibleDataset
+ * (or any chunked dataset whose first dimension is unlimited). The dataset is grown
+ * with H5Dset_extent and only the new frames are written.
+ * @param locationID The parent location that contains the dataset
+ * @param datasetName The name of the dataset
+ * @param numElements The number of elements in data. Must be a multiple of the number of elements in one frame
+ * @param data The frames to append, packed contiguously
+ * @return Standard HDF5 error conditions
+ */
+template <typename T>
+inline herr_t appendPointerDataset(hid_t locationID, const std::string& datasetName, hsize_t numElements, const T* data)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t error = 0;
+  herr_t returnError = 0;
+
+  if(nullptr == data)
+  {
+    return -2;
+  }
+  hid_t dataType = HDFTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return -1;
+  }
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
+  {
+    std::cout << "H5Lite.h::appendPointerDataset(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    return -1;
+  }
+
+  int32_t rank = -1;
+  std::vector<hsize_t> dims;
+  std::vector<hsize_t> maxDims;
+  DataspaceHandle fileSpace(H5Dget_space(dataset.get()));
+  if(fileSpace.isValid())
+  {
+    rank = H5Sget_simple_extent_ndims(fileSpace.get());
+    if(rank > 0)
+    {
+      dims.resize(rank, 0);
+      maxDims.resize(rank, 0);
+      H5Sget_simple_extent_dims(fileSpace.get(), dims.data(), maxDims.data());
+    }
+  }
+  if(rank <= 0 || maxDims[0] != H5S_UNLIMITED)
+  {
+    std::cout << "H5Lite.h::appendPointerDataset(" << __LINE__ << ") Dataset '" << datasetName << "' is not extendible along its first dimension" << std::endl;
+    return -3;
+  }
+
+  hsize_t frameElements = std::accumulate(dims.cbegin() + 1, dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+  if(numElements == 0 || numElements % frameElements != 0)
+  {
+    std::cout << "H5Lite.h::appendPointerDataset(" << __LINE__ << ") The number of elements (" << numElements << ") is not a multiple of the frame size (" << frameElements << ")" << std::endl;
+    return -4;
+  }
+
+  std::vector<hsize_t> start(dims.size(), 0);
+  std::vector<hsize_t> count(dims.cbegin(), dims.cend());
+  start[0] = dims[0];
+  count[0] = numElements / frameElements;
+  dims[0] += count[0];
+
+  error = H5Dset_extent(dataset.get(), dims.data());
+  if(error < 0)
+  {
+    std::cout << "H5Lite.h::appendPointerDataset(" << __LINE__ << ") Error extending Dataset '" << datasetName << "'" << std::endl;
+    return error;
+  }
+  DataspaceHandle memSpace;
+  error = detail::createHyperslabDataspaces(dataset.get(), static_cast<int32_t>(start.size()), start.data(), nullptr, count.data(), nullptr, fileSpace, memSpace);
+  if(error < 0)
+  {
+    return error;
+  }
+  error = H5Dwrite(dataset.get(), dataType, memSpace.get(), fileSpace.get(), H5P_DEFAULT, data);
+  if(error < 0)
+  {
+    std::cout << "Error Appending Data to '" << datasetName << "'" << std::endl;
+    returnError = error;
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+
+/**
+ * @brief Appends the frames held in a std::vector to the end of an extendible dataset.
+ * @param locationID The parent location that contains the dataset
+ * @param datasetName The name of the dataset
+ * @param data The frames to append. The size must be a multiple of the number of elements in one frame
+ * @return Standard HDF5 error conditions
+ */
+template <typename T>
+inline herr_t appendVectorDataset(hid_t locationID, const std::string& datasetName, const std::vector<T>& data)
+{
+  return appendPointerDataset(locationID, datasetName, static_cast<hsize_t>(data.size()), data.data());
+}
+
+/**
+ * @brief Creates a Dataset with the given name at the location defined by locationID from a std::array
+ *
+ * @param locationID The Parent location to store the data
+ * @param datasetName The name of the dataset
+ * @param dims The dimensions of the dataset
+ * @param data The data to write to the file
+ * @return Standard HDF5 error conditions
+ */
+template <typename T, size_t _Size>
+inline herr_t writeArrayDataset(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& dims, const std::array<T, _Size>& data)
+{
+  return writePointerDataset(locationID, datasetName, static_cast<int32_t>(dims.size()), dims.data(), data.data());
+}
+
+/**
+ * @brief Creates a Dataset with the given name at the location defined by locationID from a std::array
+ *
+ * @param locationID The Parent location to store the data
+ * @param datasetName The name of the dataset
+ * @param dims The dimensions of the dataset
+ * @param data The data to write to the file
+ * @param options The layout, filters, allocation and fill settings of the new dataset
+ * @return Standard HDF5 error conditions
+ */
+template <typename T, size_t _Size>
+inline herr_t writeArrayDataset(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& dims, const std::array<T, _Size>& data, const DatasetCreateOptions& options)
+{
+  return writePointerDataset(locationID, datasetName, static_cast<int32_t>(dims.size()), dims.data(), data.data(), options);
+}
+
+/**
+ * @brief Creates a Dataset with the given name at the location defined by locationID.
+ * This version of writeDataset should be used with a single scalar value. If you
+ * need to write an array of values, use the form that takes an std::vector<>
+ *
+ * @param locationID The Parent location to store the data
+ * @param datasetName The name of the dataset
+ * @param value The value to write to the HDF5 dataset
+ * @param options The layout, filters, allocation and fill settings of the new dataset
+ * @return Standard HDF5 error conditions
+ */
+template <typename T>
+inline herr_t writeScalarDataset(hid_t locationID, const char* datasetName, const T& value, const DatasetCreateOptions& options)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t returnError = 0;
+  hsize_t dims = 1;
+  hid_t rank = 1;
+  hid_t dataType = HDFTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return -1;
+  }
+  // Create the DataSpace
+  DataspaceHandle dataspace(H5Screate_simple(static_cast<int>(rank), &(dims), nullptr));
+  if(!dataspace.isValid())
+  {
+    return static_cast<herr_t>(dataspace.get());
+  }
+  PropertyListHandle createPropertyList;
+  if(!options.isDefault() || detail::useCompactLayout(options, 1, &dims, sizeof(T)))
+  {
+    createPropertyList.reset(detail::createDatasetPropertyList(options, 1, &dims, sizeof(T)));
+    if(!createPropertyList.isValid())
+    {
+      return -1;
+    }
+  }
+  // Create the Dataset
+  DatasetHandle dataset(H5Dcreate(locationID, datasetName, dataType, dataspace.get(), H5P_DEFAULT, createPropertyList.isValid() ? createPropertyList.get() : H5P_DEFAULT, H5P_DEFAULT));
+  if(!dataset.isValid())
+  {
+    return static_cast<herr_t>(dataset.get());
+  }
+  herr_t error = H5Dwrite(dataset.get(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, &value);
+  if(error < 0)
+  {
+    std::cout << "Error Writing Data" << std::endl;
+    returnError = error;
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset." << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+
+/**
+ * @brief Creates a Dataset with the given name at the location defined by locationID
+ * @param locationID The Parent location to store the data
+ * @param datasetName The name of the dataset
+ * @param value The value to write to the HDF5 dataset
+ * @return Standard HDF5 error conditions
+ */
+template <typename T>
+inline herr_t writeScalarDataset(hid_t locationID, const char* datasetName, const T& value)
+{
+  return writeScalarDataset(locationID, datasetName, value, DatasetCreateOptions());
+}
+
+/**
+ * @brief std::string overload of writeScalarDataset
+ */
+template <typename T>
+inline herr_t writeScalarDataset(hid_t locationID, const std::string& datasetName, const T& value)
+{
+  return writeScalarDataset(locationID, datasetName.c_str(), value);
+}
+
+/**
+ * @brief std::string overload of writeScalarDataset
+ */
+template <typename T>
+inline herr_t writeScalarDataset(hid_t locationID, const std::string& datasetName, const T& value, const DatasetCreateOptions& options)
+{
+  return writeScalarDataset(locationID, datasetName.c_str(), value, options);
+}
+
+/**
+ * @brief Writes a std::string as a HDF Dataset.
+ * @param locationID The Parent location to write the dataset
+ * @param datasetName The Name to use for the dataset
+ * @param data The actual data to write as a null terminated string
+ * @return Standard HDF5 error conditions
+ */
+inline herr_t writeStringDataset(hid_t locationID, const std::string& datasetName, const std::string& data)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t returnError = 0;
+  /* create a string data type */
+  TypeHandle dataType(H5Tcopy(H5T_C_S1));
+  if(!dataType.isValid())
+  {
+    return static_cast<herr_t>(dataType.get());
+  }
+  size_t size = data.size() + 1;
+  if(H5Tset_size(dataType.get(), size) < 0 || H5Tset_strpad(dataType.get(), H5T_STR_NULLTERM) < 0)
+  {
+    std::cout << "Error Setting the String Type of Dataset '" << datasetName << "'" << std::endl;
+    return -1;
+  }
+  /* Create the data space for the dataset. */
+  DataspaceHandle dataspace(H5Screate(H5S_SCALAR));
+  if(!dataspace.isValid())
+  {
+    return static_cast<herr_t>(dataspace.get());
+  }
+  /* Create or open the dataset. */
+  HDF_ERROR_HANDLER_OFF
+  DatasetHandle dataset(H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT));
+  HDF_ERROR_HANDLER_ON
+  if(!dataset.isValid()) // dataset does not exist so create it
+  {
+    PropertyListHandle createPropertyList;
+    if(detail::useCompactLayout(DatasetCreateOptions(), 0, nullptr, size))
+    {
+      createPropertyList.reset(detail::createDatasetPropertyList(DatasetCreateOptions(), 0, nullptr, size));
+    }
+    dataset.reset(H5Dcreate(locationID, datasetName.c_str(), dataType.get(), dataspace.get(), H5P_DEFAULT, createPropertyList.isValid() ? createPropertyList.get() : H5P_DEFAULT, H5P_DEFAULT));
+  }
+  if(!dataset.isValid())
+  {
+    std::cout << "Error Creating String Dataset '" << datasetName << "'" << std::endl;
+    return static_cast<herr_t>(dataset.get());
+  }
+  if(!data.empty())
+  {
+    herr_t error = H5Dwrite(dataset.get(), dataType.get(), H5S_ALL, H5S_ALL, H5P_DEFAULT, data.c_str());
+    if(error < 0)
+    {
+      std::cout << "Error Writing String Data" << std::endl;
+      returnError = error;
+    }
+  }
+  herr_t error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+
+/**
+ * @brief Writes a null terminated 'C String' to an HDF Dataset.
+ * @param locationID The Parent location to write the dataset
+ * @param datasetName The Name to use for the dataset
+ * @param size The number of characters in the string
+ * @param data const char pointer to write as a null terminated string
+ * @return Standard HDF5 error conditions
+ */
+inline herr_t writeStringDataset(hid_t locationID, const std::string& datasetName, size_t size, const char* data)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t returnError = 0;
+  /* create a string data type */
+  TypeHandle dataType(H5Tcopy(H5T_C_S1));
+  if(!dataType.isValid())
+  {
+    return static_cast<herr_t>(dataType.get());
+  }
+  if(H5Tset_size(dataType.get(), size) < 0 || H5Tset_strpad(dataType.get(), H5T_STR_NULLTERM) < 0)
+  {
+    std::cout << "Error Setting the String Type of Dataset '" << datasetName << "'" << std::endl;
+    return -1;
+  }
+  /* Create the data space for the dataset. */
+  DataspaceHandle dataspace(H5Screate(H5S_SCALAR));
+  if(!dataspace.isValid())
+  {
+    return static_cast<herr_t>(dataspace.get());
+  }
+  /* Create the dataset. */
+  PropertyListHandle createPropertyList;
+  if(detail::useCompactLayout(DatasetCreateOptions(), 0, nullptr, size))
+  {
+    createPropertyList.reset(detail::createDatasetPropertyList(DatasetCreateOptions(), 0, nullptr, size));
+  }
+  DatasetHandle dataset(H5Dcreate(locationID, datasetName.c_str(), dataType.get(), dataspace.get(), H5P_DEFAULT, createPropertyList.isValid() ? createPropertyList.get() : H5P_DEFAULT, H5P_DEFAULT));
+  if(!dataset.isValid())
+  {
+    std::cout << "Error Creating String Dataset '" << datasetName << "'" << std::endl;
+    return static_cast<herr_t>(dataset.get());
+  }
+  if(nullptr != data)
+  {
+    herr_t error = H5Dwrite(dataset.get(), dataType.get(), H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    if(error < 0)
+    {
+      std::cout << "Error Writing String Data" << std::endl;
+      returnError = error;
+    }
+  }
+  herr_t error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+
+/**
+ * @brief Writes a vector of null terminated strings to an HDF dataset.
+ * @param locationID
+ * @param datasetName
+ * @param size
+ * @param data
+ * @return
+ */
+inline herr_t writeVectorOfStringsDataset(hid_t locationID, const std::string& datasetName, const std::vector<std::string>& data)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t returnError = 0;
+
+  std::array<hsize_t, 1> dims = {data.size()};
+  DataspaceHandle dataspace(H5Screate_simple(static_cast<int>(dims.size()), dims.data(), nullptr));
+  if(!dataspace.isValid())
+  {
+    return static_cast<herr_t>(dataspace.get());
+  }
+  dims[0] = 1;
+  DataspaceHandle memSpace(H5Screate_simple(static_cast<int>(dims.size()), dims.data(), nullptr));
+  if(!memSpace.isValid())
+  {
+    return static_cast<herr_t>(memSpace.get());
+  }
+  TypeHandle dataType(H5Tcopy(H5T_C_S1));
+  if(!dataType.isValid() || H5Tset_size(dataType.get(), H5T_VARIABLE) < 0)
+  {
+    std::cout << "Error Setting the String Type of Dataset '" << datasetName << "'" << std::endl;
+    return -1;
+  }
+  DatasetHandle dataset(H5Dcreate(locationID, datasetName.c_str(), dataType.get(), dataspace.get(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+  if(!dataset.isValid())
+  {
+    return static_cast<herr_t>(dataset.get());
+  }
+  // Select the "memory" to be written out - just 1 record.
+  hsize_t dataset_offset[] = {0};
+  hsize_t dataset_count[] = {1};
+  H5Sselect_hyperslab(memSpace.get(), H5S_SELECT_SET, dataset_offset, nullptr, dataset_count, nullptr);
+  hsize_t pos = 0;
+  for(const auto& element : data)
+  {
+    // Select the file position, 1 record at position 'pos'
+    hsize_t element_count[] = {1};
+    hsize_t element_offset[] = {pos};
+    pos++;
+    H5Sselect_hyperslab(dataspace.get(), H5S_SELECT_SET, element_offset, nullptr, element_count, nullptr);
+    const char* strPtr = element.c_str();
+    herr_t error = H5Dwrite(dataset.get(), dataType.get(), memSpace.get(), dataspace.get(), H5P_DEFAULT, &strPtr);
+    if(error < 0)
+    {
+      std::cout << "Error Writing String Data: " __FILE__ << "(" << __LINE__ << ")" << std::endl;
+      returnError = error;
+    }
+  }
+  herr_t error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
   }
   return returnError;
 }
 
 /**
- * @brief Writes an Attribute to an HDF5 Object
+ * @brief Writes an Attribute to an HDF5 Object. An existing attribute with the same type and
+ * dimensions is overwritten in place, any other existing attribute is replaced.
  * @param locationID The Parent Location of the HDFobject that is getting the attribute
  * @param objectName The Name of Object to write the attribute into.
  * @param attributeName The Name of the Attribute
@@ -1248,91 +2363,29 @@ inline herr_t writePointerAttribute(hid_t locationID, const std::string& objectN
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t objectID, dataspaceID, attributeID;
-  herr_t hasAttribute;
   H5O_info_t objectInfo;
-  herr_t error = 0;
-  herr_t returnError = 0;
   hid_t dataType = HDFTypeForPrimitive<T>();
   if(dataType == -1)
   {
     std::cout << "dataType was unknown" << std::endl;
     return -1;
   }
-  /* Get the type of object */
 
-  if(H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT) < 0)
-  {
-    std::cout << "Error getting object info at locationID (" << locationID << ") with object name (" << objectName << ")" << std::endl;
-    return -1;
-  }
   /* Open the object */
-  objectID = openId(locationID, objectName, objectInfo.type);
-  if(objectID < 0)
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectInfo.type));
+  if(!object.isValid())
   {
-    std::cout << "Error opening Object for Attribute operations." << std::endl;
+    std::cout << "Error opening Object for Attribute operations at locationID (" << locationID << ") with object name (" << objectName << ")" << std::endl;
     return -1;
   }
 
-  dataspaceID = H5Screate_simple(rank, dims, nullptr);
-  if(dataspaceID >= 0)
-  {
-    /* Verify if the attribute already exists */
-    hasAttribute = findAttribute(objectID, attributeName);
-
-    /* The attribute already exists, delete it */
-    if(hasAttribute == 1)
-    {
-      error = H5Adelete(objectID, attributeName.c_str());
-      if(error < 0)
-      {
-        std::cout << "Error Deleting Existing Attribute" << std::endl;
-        returnError = error;
-      }
-    }
-
-    if(error >= 0)
-    {
-      /* Create the attribute. */
-      attributeID = H5Acreate(objectID, attributeName.c_str(), dataType, dataspaceID, H5P_DEFAULT, H5P_DEFAULT);
-      if(attributeID >= 0)
-      {
-        /* Write the attribute data. */
-        error = H5Awrite(attributeID, dataType, data);
-        if(error < 0)
-        {
-          std::cout << "Error Writing Attribute" << std::endl;
-          returnError = error;
-        }
-      }
-      /* Close the attribute. */
-      error = H5Aclose(attributeID);
-      if(error < 0)
-      {
-        std::cout << "Error Closing Attribute" << std::endl;
-        returnError = error;
-      }
-    }
-    /* Close the dataspace. */
-    error = H5Sclose(dataspaceID);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Dataspace" << std::endl;
-      returnError = error;
-    }
-  }
-  else
-  {
-    returnError = static_cast<herr_t>(dataspaceID);
-  }
-  /* Close the object */
-  error = closeId(objectID, objectInfo.type);
-  if(error < 0)
+  DataspaceHandle dataspace(H5Screate_simple(rank, dims, nullptr));
+  if(!dataspace.isValid())
   {
-    std::cout << "Error Closing HDF5 Object ID" << std::endl;
-    returnError = error;
+    return static_cast<herr_t>(dataspace.get());
   }
-  return returnError;
+  /* Overwrite an existing attribute of the same type and shape, otherwise (re)create it */
+  return detail::writeAttribute(object.get(), attributeName.c_str(), dataType, dataspace.get(), data);
 }
 
 /**
@@ -1351,7 +2404,8 @@ inline herr_t writeVectorAttribute(hid_t locationID, const std::string& objectNa
 }
 
 /**
- * @brief Writes a null terminated string as an attribute
+ * @brief Writes a null terminated string as an attribute. An existing string attribute of the
+ * same size is overwritten in place, any other existing attribute is replaced.
  * @param locationID The location to look for objectName
  * @param objectName The Object to write the attribute to
  * @param attributeName The name of the Attribute
@@ -1363,94 +2417,24 @@ inline herr_t writeStringAttribute(hid_t locationID, const std::string& objectNa
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t attributeType;
-  hid_t attributeSpaceID;
-  hid_t attributeID;
-  hid_t objectID;
-  int32_t hasAttribute;
-  H5O_info_t objectInfo{};
-  size_t attributeSize;
-  herr_t error = 0;
-  herr_t returnError = 0;
-
-  /* Get the type of object */
-  returnError = H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT);
-  if(returnError >= 0)
+  /* Open the object */
+  H5O_type_t objectType = H5O_TYPE_UNKNOWN;
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectType));
+  if(!object.isValid())
   {
-    /* Open the object */
-    objectID = openId(locationID, objectName, objectInfo.type);
-    if(objectID >= 0)
-    {
-      /* Create the attribute */
-      attributeType = H5Tcopy(H5T_C_S1);
-      if(attributeType >= 0)
-      {
-        attributeSize = size; /* extra null term */
-        error = H5Tset_size(attributeType, attributeSize);
-        if(error < 0)
-        {
-          std::cout << "Error Setting H5T Size" << std::endl;
-          returnError = error;
-        }
-        if(error >= 0)
-        {
-          error = H5Tset_strpad(attributeType, H5T_STR_NULLTERM);
-          if(error < 0)
-          {
-            std::cout << "Error adding a null terminator." << std::endl;
-            returnError = error;
-          }
-          if(error >= 0)
-          {
-            attributeSpaceID = H5Screate(H5S_SCALAR);
-            if(attributeSpaceID >= 0)
-            {
-              /* Verify if the attribute already exists */
-              hasAttribute = findAttribute(objectID, attributeName);
-              /* The attribute already exists, delete it */
-              if(hasAttribute == 1)
-              {
-                error = H5Adelete(objectID, attributeName.c_str());
-                if(error < 0)
-                {
-                  std::cout << "Error Deleting Attribute '" << attributeName << "' from Object '" << objectName << "'" << std::endl;
-                  returnError = error;
-                }
-              }
-              if(error >= 0)
-              {
-                /* Create and write the attribute */
-                attributeID = H5Acreate(objectID, attributeName.c_str(), attributeType, attributeSpaceID, H5P_DEFAULT, H5P_DEFAULT);
-                if(attributeID >= 0)
-                {
-                  error = H5Awrite(attributeID, attributeType, data);
-                  if(error < 0)
-                  {
-                    std::cout << "Error Writing String attribute." << std::endl;
-
-                    returnError = error;
-                  }
-                }
-                CloseH5A(attributeID, error, returnError);
-              }
-              CloseH5S(attributeSpaceID, error, returnError);
-            }
-          }
-        }
-        CloseH5T(attributeType, error, returnError);
-      }
-      else
-      {
-        // returnError = attributeType;
-      }
-      /* Close the object */
-      error = closeId(objectID, objectInfo.type);
-      if(error < 0)
-      {
-        std::cout << "Error Closing Object Id" << std::endl;
-        returnError = error;
-      }
-    }
+    return static_cast<herr_t>(object.get());
+  }
+  /* Overwrite an existing string of the same length, otherwise (re)create it */
+  herr_t returnError = detail::writeStringAttribute(object.get(), attributeName.c_str(), size, data);
+  if(returnError < 0)
+  {
+    std::cout << "Error Writing String Attribute '" << attributeName << "' to Object '" << objectName << "'" << std::endl;
+  }
+  herr_t error = object.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Object Id" << std::endl;
+    returnError = error;
   }
   return returnError;
 }
@@ -1481,303 +2465,608 @@ inline herr_t writeStringAttributes(hid_t locationID, const std::string& objectN
 {
   H5SUPPORT_MUTEX_LOCK()
 
+  /* Open the object once for all of the attributes */
+  H5O_type_t objectType = H5O_TYPE_UNKNOWN;
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectType));
+  if(!object.isValid())
+  {
+    std::cout << "Error opening Object for Attribute operations at locationID (" << locationID << ") with object name (" << objectName << ")" << std::endl;
+    return -1;
+  }
   herr_t error = 0;
   for(const auto& attribute : attributes)
   {
-    error = writeStringAttribute(locationID, objectName, attribute.first, attribute.second);
+    error = detail::writeStringAttribute(object.get(), attribute.first.c_str(), attribute.second.size() + 1, attribute.second.c_str());
     if(error < 0)
     {
       return error;
     }
   }
-  return error;
+  return object.close();
+}
+
+/**
+ * @brief Returns the total number of elements in the supplied dataset
+ * @param locationID The parent location that contains the dataset to read
+ * @param datasetName The name of the dataset to read
+ * @return Number of elements in dataset
+ */
+inline hsize_t getNumberOfElements(hid_t locationID, const std::string& datasetName)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hsize_t numElements = 0;
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
+  {
+    std::cout << "H5Lite.cpp::getNumberOfElements(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    return -1;
+  }
+  DataspaceHandle dataspace(H5Dget_space(dataset.get()));
+  if(dataspace.isValid())
+  {
+    int32_t rank = H5Sget_simple_extent_ndims(dataspace.get());
+    if(rank > 0)
+    {
+      std::vector<hsize_t> dims(rank, 0); // Allocate enough room for the dims
+      H5Sget_simple_extent_dims(dataspace.get(), dims.data(), nullptr);
+      numElements = std::accumulate(dims.cbegin(), dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+    }
+  }
+  else
+  {
+    std::cout << "Error Opening SpaceID" << std::endl;
+  }
+  return numElements;
+}
+
+/**
+ * @brief Writes an attribute to the given object. This method is designed with
+ * a Template parameter that represents a primitive value. If you need to write
+ * an array, please use the other over loaded method that takes a vector. An existing
+ * attribute with the same type is overwritten in place.
+ * @param locationID The location to look for objectName
+ * @param objectName The Object to write the attribute to
+ * @param attributeName The  name of the attribute
+ * @param data The data to be written as the attribute
+ * @return Standard HDF error condition
+ */
+template <typename T>
+inline herr_t writeScalarAttribute(hid_t locationID, const char* objectName, const char* attributeName, T data)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  H5O_info_t objectInfo;
+  hsize_t dims = 1;
+  int32_t rank = 1;
+  hid_t dataType = HDFTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return -1;
+  }
+
+  /* Open the object */
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectInfo.type));
+  if(!object.isValid())
+  {
+    std::cout << "Error opening Object for Attribute operations at locationID (" << locationID << ") with object name (" << objectName << ")" << std::endl;
+    return -1;
+  }
+
+  DataspaceHandle dataspace(H5Screate_simple(rank, &dims, nullptr));
+  if(!dataspace.isValid())
+  {
+    return static_cast<herr_t>(dataspace.get());
+  }
+  /* Overwrite an existing attribute of the same type and shape, otherwise (re)create it */
+  return detail::writeAttribute(object.get(), attributeName, dataType, dataspace.get(), &data);
+}
+
+/**
+ * @brief std::string overload of writeScalarAttribute
+ */
+template <typename T>
+inline herr_t writeScalarAttribute(hid_t locationID, const std::string& objectName, const std::string& attributeName, T data)
+{
+  return writeScalarAttribute(locationID, objectName.c_str(), attributeName.c_str(), data);
+}
+
+/**
+ * @brief Reads data from the HDF5 File into a preallocated array.
+ * @param locationID The parent location that contains the dataset to read
+ * @param datasetName The name of the dataset to read
+ * @param data A Pointer to the PreAllocated Array of Data
+ * @return Standard HDF error condition
+ */
+template <typename T>
+inline herr_t readPointerDataset(hid_t locationID, const char* datasetName, T* data)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t error = 0;
+  herr_t returnError = 0;
+  hid_t dataType = HDFTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    std::cout << "dataType was not supported." << std::endl;
+    return -10;
+  }
+  if(locationID < 0)
+  {
+    std::cout << "locationID was Negative: This is not allowed." << std::endl;
+    return -2;
+  }
+  if(nullptr == data)
+  {
+    std::cout << "The Pointer to hold the data is nullptr. This is NOT allowed." << std::endl;
+    return -3;
+  }
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
+  {
+    std::cout << " Error opening Dataset: " << dataset.get() << std::endl;
+    return -1;
+  }
+  error = H5Dread(dataset.get(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+  if(error < 0)
+  {
+    std::cout << "Error Reading Data." << std::endl;
+    returnError = error;
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset id" << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+
+/**
+ * @brief std::string overload of readPointerDataset
+ */
+template <typename T>
+inline herr_t readPointerDataset(hid_t locationID, const std::string& datasetName, T* data)
+{
+  return readPointerDataset(locationID, datasetName.c_str(), data);
+}
+
+/**
+ * @brief Reads data from the HDF5 File into an std::vector<T> object. If the dataset
+ * is very large this can be an expensive method to use. It is here for convenience
+ * using STL with hdf5.
+ * @param locationID The parent location that contains the dataset to read
+ * @param datasetName The name of the dataset to read
+ * @param data A std::vector<T>. Note the vector WILL be resized to fit the data.
+ * The best idea is to just allocate the vector but not to size it. The method
+ * will size it for you.
+ * @return Standard HDF error condition
+ */
+template <typename T>
+inline herr_t readVectorDataset(hid_t locationID, const std::string& datasetName, std::vector<T>& data)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t error = 0;
+  herr_t returnError = 0;
+  hid_t dataType = HDFTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return -1;
+  }
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
+  {
+    std::cout << "H5Lite.h::readVectorDataset(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    return -1;
+  }
+  DataspaceHandle dataspace(H5Dget_space(dataset.get()));
+  if(!dataspace.isValid())
+  {
+    std::cout << "Error Opening SpaceID" << std::endl;
+    return static_cast<herr_t>(dataspace.get());
+  }
+  int32_t rank = H5Sget_simple_extent_ndims(dataspace.get());
+  if(rank > 0)
+  {
+    std::vector<hsize_t> dims(rank, 0); // Allocate enough room for the dims
+    error = H5Sget_simple_extent_dims(dataspace.get(), dims.data(), nullptr);
+    hsize_t numElements = std::accumulate(dims.cbegin(), dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+    // Resize the vector
+    data.resize(numElements);
+    error = H5Dread(dataset.get(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+    if(error < 0)
+    {
+      std::cout << "Error Reading Data.'" << datasetName << "'" << std::endl;
+      returnError = error;
+    }
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset" << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+
+#ifdef H5Support_HAVE_PARALLEL_DEFLATE
+namespace detail
+{
+/**
+ * @brief Returns true if every chunk of a chunked, deflate-only dataset whose file type matches T
+ * can be read raw and inflated by this library.
+ * @param datasetID The open dataset
+ * @param dims The dimensions of the dataset
+ * @param cDims Receives the chunk dimensions
+ * @return True if the dataset can be read with readDeflatedChunks
+ */
+template <typename T>
+inline bool canReadDeflatedChunks(hid_t datasetID, const std::vector<hsize_t>& dims, std::vector<hsize_t>& cDims)
+{
+  bool supported = false;
+  PropertyListHandle propertyList(H5Dget_create_plist(datasetID));
+  if(!propertyList.isValid())
+  {
+    return false;
+  }
+  if(H5Pget_layout(propertyList.get()) == H5D_CHUNKED && H5Pget_nfilters(propertyList.get()) == 1)
+  {
+    uint32_t flags = 0;
+    size_t numValues = 0;
+    uint32_t filterConfig = 0;
+    H5Z_filter_t filter = H5Pget_filter2(propertyList.get(), 0, &flags, &numValues, nullptr, 0, nullptr, &filterConfig);
+    cDims.resize(dims.size());
+    supported = filter == H5Z_FILTER_DEFLATE && H5Pget_chunk(propertyList.get(), static_cast<int>(cDims.size()), cDims.data()) == static_cast<int>(dims.size());
+  }
+
+  if(supported)
+  {
+    TypeHandle type(H5Dget_type(datasetID));
+    supported = type.isValid() && H5Tequal(type.get(), HDFTypeForPrimitive<T>()) > 0;
+  }
+  if(supported)
+  {
+    // Chunks that were never written hold the fill value and have nothing to inflate
+    DataspaceHandle dataspace(H5Dget_space(datasetID));
+    hsize_t numChunks = 0;
+    supported = dataspace.isValid() && H5Dget_num_chunks(datasetID, dataspace.get(), &numChunks) >= 0;
+    const std::vector<hsize_t> grid = getChunkGrid(dims, cDims);
+    supported = supported && numChunks == std::accumulate(grid.begin(), grid.end(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+  }
+  return supported;
 }
 
 /**
- * @brief Returns the total number of elements in the supplied dataset
- * @param locationID The parent location that contains the dataset to read
- * @param datasetName The name of the dataset to read
- * @return Number of elements in dataset
+ * @brief Reads a whole dataset into a preallocated array. Deflate compressed datasets have their raw chunks
+ * fetched with H5Dread_chunk and inflated on a pool of threads straight into the array. Any other dataset is
+ * read with a plain H5Dread.
+ * @param datasetID The open dataset
+ * @param data The preallocated array
+ * @param numThreads The number of decompression threads. 0 uses every hardware thread.
+ * @return Standard HDF error condition
  */
-inline hsize_t getNumberOfElements(hid_t locationID, const std::string& datasetName)
+template <typename T>
+inline herr_t readDeflatedChunks(hid_t datasetID, T* data, size_t numThreads)
 {
-  H5SUPPORT_MUTEX_LOCK()
+  DataspaceHandle dataspace(H5Dget_space(datasetID));
+  if(!dataspace.isValid())
+  {
+    return static_cast<herr_t>(dataspace.get());
+  }
+  int32_t rank = H5Sget_simple_extent_ndims(dataspace.get());
+  std::vector<hsize_t> dims(std::max(rank, 0), 0);
+  if(rank > 0)
+  {
+    H5Sget_simple_extent_dims(dataspace.get(), dims.data(), nullptr);
+  }
+  dataspace.close();
 
-  hid_t datasetID;
-  herr_t error = 0;
-  hid_t dataspaceID;
-  hsize_t numElements = 0;
-  datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT);
-  if(datasetID < 0)
+  std::vector<hsize_t> cDims;
+  if(rank <= 0 || !canReadDeflatedChunks<T>(datasetID, dims, cDims))
   {
-    std::cout << "H5Lite.cpp::getNumberOfElements(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
-    return -1;
+    return H5Dread(datasetID, HDFTypeForPrimitive<T>(), H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
   }
-  if(datasetID >= 0)
+
+  const std::vector<hsize_t> grid = getChunkGrid(dims, cDims);
+  const hsize_t numChunks = std::accumulate(grid.begin(), grid.end(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+  const size_t chunkBytes = std::accumulate(cDims.begin(), cDims.end(), sizeof(T), std::multiplies<size_t>());
+  // A chunk that spans every dimension but the slowest one is a contiguous block of the array
+  const bool rowChunks = std::equal(cDims.begin() + 1, cDims.end(), dims.begin() + 1);
+
+  // The raw chunks are read by this thread (the library is not thread safe) a batch at a time
+  numThreads = getNumberOfThreads(numThreads);
+  const size_t batchSize = numThreads * 4;
+  std::vector<std::vector<uint8_t>> compressedChunks(batchSize);
+  std::vector<std::vector<uint8_t>> rawChunks(batchSize);
+  std::vector<uint32_t> filterMasks(batchSize, 0);
+  std::vector<int> zlibErrors(batchSize, Z_OK);
+  std::vector<hsize_t> offsets(batchSize * rank, 0);
+  uint8_t* array = reinterpret_cast<uint8_t*>(data);
+
+  for(hsize_t batchStart = 0; batchStart < numChunks; batchStart += batchSize)
   {
-    dataspaceID = H5Dget_space(datasetID);
-    if(dataspaceID > 0)
+    const size_t count = static_cast<size_t>(std::min<hsize_t>(batchSize, numChunks - batchStart));
+    for(size_t i = 0; i < count; i++)
     {
-      int32_t rank = H5Sget_simple_extent_ndims(dataspaceID);
-      if(rank > 0)
+      hsize_t* offset = offsets.data() + i * rank;
+      getChunkOffset(grid, cDims, batchStart + i, offset);
+      hsize_t storageSize = 0;
+      if(H5Dget_chunk_storage_size(datasetID, offset, &storageSize) < 0)
       {
-        std::vector<hsize_t> dims(rank, 0); // Allocate enough room for the dims
-        error = H5Sget_simple_extent_dims(dataspaceID, dims.data(), nullptr);
-        numElements = std::accumulate(dims.cbegin(), dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+        return -1;
       }
-      error = H5Sclose(dataspaceID);
-      if(error < 0)
+      compressedChunks[i].resize(storageSize);
+      if(H5Dread_chunk(datasetID, H5P_DEFAULT, offset, &filterMasks[i], compressedChunks[i].data()) < 0)
       {
-        std::cout << "Error Closing Data Space" << std::endl;
+        return -1;
       }
     }
-    else
-    {
-      std::cout << "Error Opening SpaceID" << std::endl;
-    }
-    error = H5Dclose(datasetID);
-    if(error < 0)
+
+    parallelFor(numThreads, count, [&](size_t i) {
+      const hsize_t* offset = offsets.data() + i * rank;
+      std::vector<uint8_t>& compressed = compressedChunks[i];
+      // A set bit 0 in the filter mask means deflate was skipped for this chunk
+      if((filterMasks[i] & 1u) != 0)
+      {
+        compressed.resize(chunkBytes, 0);
+        copyChunk(dims, cDims, offset, sizeof(T), array, compressed.data(), false);
+        zlibErrors[i] = Z_OK;
+        return;
+      }
+      uLongf inflatedSize = static_cast<uLongf>(chunkBytes);
+      if(rowChunks && offset[0] + cDims[0] <= dims[0])
+      {
+        uint8_t* destination = array + static_cast<size_t>(offset[0]) * (chunkBytes / static_cast<size_t>(cDims[0]));
+        zlibErrors[i] = uncompress(destination, &inflatedSize, compressed.data(), static_cast<uLong>(compressed.size()));
+      }
+      else
+      {
+        rawChunks[i].resize(chunkBytes);
+        zlibErrors[i] = uncompress(rawChunks[i].data(), &inflatedSize, compressed.data(), static_cast<uLong>(compressed.size()));
+        if(zlibErrors[i] == Z_OK)
+        {
+          copyChunk(dims, cDims, offset, sizeof(T), array, rawChunks[i].data(), false);
+        }
+      }
+      if(zlibErrors[i] == Z_OK && inflatedSize != chunkBytes)
+      {
+        zlibErrors[i] = Z_DATA_ERROR;
+      }
+    });
+
+    for(size_t i = 0; i < count; i++)
     {
-      std::cout << "Error Closing Dataset" << std::endl;
+      if(zlibErrors[i] != Z_OK)
+      {
+        std::cout << "H5Lite.h::readDeflatedChunks(" << __LINE__ << ") zlib error " << zlibErrors[i] << " inflating a chunk" << std::endl;
+        return -1;
+      }
     }
   }
-  return numElements;
+  return 0;
 }
+} // namespace detail
 
 /**
- * @brief Writes an attribute to the given object. This method is designed with
- * a Template parameter that represents a primitive value. If you need to write
- * an array, please use the other over loaded method that takes a vector.
- * @param locationID The location to look for objectName
- * @param objectName The Object to write the attribute to
- * @param attributeName The  name of the attribute
- * @param data The data to be written as the attribute
+ * @brief Reads data from the HDF5 File into a preallocated array. Deflate compressed datasets are
+ * decompressed on a pool of threads instead of inside H5Dread. Datasets using other filters, a type
+ * conversion or containing unwritten chunks are read with H5Dread.
+ * @param locationID The parent location that contains the dataset to read
+ * @param datasetName The name of the dataset to read
+ * @param data A Pointer to the PreAllocated Array of Data
+ * @param numThreads The number of decompression threads. 0 uses every hardware thread.
  * @return Standard HDF error condition
  */
 template <typename T>
-inline herr_t writeScalarAttribute(hid_t locationID, const std::string& objectName, const std::string& attributeName, T data)
+inline herr_t readPointerDatasetParallel(hid_t locationID, const std::string& datasetName, T* data, size_t numThreads = 0)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t objectID, dataspaceID, attributeID;
-  herr_t hasAttribute;
-  H5O_info_t objectInfo;
   herr_t error = 0;
   herr_t returnError = 0;
-  hsize_t dims = 1;
-  int32_t rank = 1;
-  hid_t dataType = HDFTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    return -1;
-  }
-  /* Get the type of object */
-  error = H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT);
-  if(error < 0)
+  if(HDFTypeForPrimitive<T>() == -1)
   {
-    std::cout << "Error getting object info at locationID (" << locationID << ") with object name (" << objectName << ")" << std::endl;
-    return error;
+    std::cout << "dataType was not supported." << std::endl;
+    return -10;
   }
-  /* Open the object */
-  objectID = openId(locationID, objectName, objectInfo.type);
-  if(objectID < 0)
+  if(nullptr == data)
   {
-    std::cout << "Error opening Object for Attribute operations." << std::endl;
-    return static_cast<herr_t>(objectID);
+    std::cout << "The Pointer to hold the data is nullptr. This is NOT allowed." << std::endl;
+    return -3;
   }
-
-  /* Create the data space for the attribute. */
-  dataspaceID = H5Screate_simple(rank, &dims, nullptr);
-  if(dataspaceID >= 0)
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
   {
-    /* Verify if the attribute already exists */
-    hasAttribute = findAttribute(objectID, attributeName);
-
-    /* The attribute already exists, delete it */
-    if(hasAttribute == 1)
-    {
-      error = H5Adelete(objectID, attributeName.c_str());
-      if(error < 0)
-      {
-        std::cout << "Error Deleting Existing Attribute" << std::endl;
-        returnError = error;
-      }
-    }
-
-    if(error >= 0)
-    {
-      /* Create the attribute. */
-      attributeID = H5Acreate(objectID, attributeName.c_str(), dataType, dataspaceID, H5P_DEFAULT, H5P_DEFAULT);
-      if(attributeID >= 0)
-      {
-        /* Write the attribute data. */
-        error = H5Awrite(attributeID, dataType, &data);
-        if(error < 0)
-        {
-          std::cout << "Error Writing Attribute" << std::endl;
-          returnError = error;
-        }
-      }
-      /* Close the attribute. */
-      error = H5Aclose(attributeID);
-      if(error < 0)
-      {
-        std::cout << "Error Closing Attribute" << std::endl;
-        returnError = error;
-      }
-    }
-    /* Close the dataspace. */
-    error = H5Sclose(dataspaceID);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Dataspace" << std::endl;
-      returnError = error;
-    }
+    std::cout << "H5Lite.h::readPointerDatasetParallel(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    return -1;
   }
-  else
+  error = detail::readDeflatedChunks(dataset.get(), data, numThreads);
+  if(error < 0)
   {
-    returnError = static_cast<herr_t>(dataspaceID);
+    std::cout << "Error Reading Data.'" << datasetName << "'" << std::endl;
+    returnError = error;
   }
-
-  /* Close the object */
-  error = closeId(objectID, objectInfo.type);
+  error = dataset.close();
   if(error < 0)
   {
-    std::cout << "Error Closing HDF5 Object ID" << std::endl;
+    std::cout << "Error Closing Dataset" << std::endl;
     returnError = error;
   }
   return returnError;
 }
 
 /**
- * @brief Reads data from the HDF5 File into a preallocated array.
+ * @brief Reads data from the HDF5 File into an std::vector<T> object, decompressing deflate compressed
+ * chunks on a pool of threads. See readPointerDatasetParallel.
  * @param locationID The parent location that contains the dataset to read
  * @param datasetName The name of the dataset to read
- * @param data A Pointer to the PreAllocated Array of Data
+ * @param data A std::vector<T>. Note the vector WILL be resized to fit the data.
+ * @param numThreads The number of decompression threads. 0 uses every hardware thread.
  * @return Standard HDF error condition
  */
 template <typename T>
-inline herr_t readPointerDataset(hid_t locationID, const std::string& datasetName, T* data)
+inline herr_t readVectorDatasetParallel(hid_t locationID, const std::string& datasetName, std::vector<T>& data, size_t numThreads = 0)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t datasetID;
   herr_t error = 0;
   herr_t returnError = 0;
-  hid_t dataType = HDFTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    std::cout << "dataType was not supported." << std::endl;
-    return -10;
-  }
-  if(locationID < 0)
+  if(HDFTypeForPrimitive<T>() == -1)
   {
-    std::cout << "locationID was Negative: This is not allowed." << std::endl;
-    return -2;
+    return -1;
   }
-  if(nullptr == data)
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
   {
-    std::cout << "The Pointer to hold the data is nullptr. This is NOT allowed." << std::endl;
-    return -3;
+    std::cout << "H5Lite.h::readVectorDatasetParallel(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    return -1;
   }
-  datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT);
-  if(datasetID < 0)
+  DataspaceHandle dataspace(H5Dget_space(dataset.get()));
+  if(!dataspace.isValid())
   {
-    std::cout << " Error opening Dataset: " << datasetID << std::endl;
-    return -1;
+    std::cout << "Error Opening SpaceID" << std::endl;
+    return static_cast<herr_t>(dataspace.get());
   }
-  if(datasetID >= 0)
+  int32_t rank = H5Sget_simple_extent_ndims(dataspace.get());
+  if(rank > 0)
   {
-    error = H5Dread(datasetID, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
-    if(error < 0)
-    {
-      std::cout << "Error Reading Data." << std::endl;
-      returnError = error;
-    }
-    error = H5Dclose(datasetID);
+    std::vector<hsize_t> dims(rank, 0);
+    H5Sget_simple_extent_dims(dataspace.get(), dims.data(), nullptr);
+    data.resize(std::accumulate(dims.cbegin(), dims.cend(), static_cast<size_t>(1), std::multiplies<size_t>()));
+    error = detail::readDeflatedChunks(dataset.get(), data.data(), numThreads);
     if(error < 0)
     {
-      std::cout << "Error Closing Dataset id" << std::endl;
+      std::cout << "Error Reading Data.'" << datasetName << "'" << std::endl;
       returnError = error;
     }
   }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset" << std::endl;
+    returnError = error;
+  }
   return returnError;
 }
+#endif
 
 /**
- * @brief Reads data from the HDF5 File into an std::vector<T> object. If the dataset
- * is very large this can be an expensive method to use. It is here for convenience
- * using STL with hdf5.
+ * @brief Reads a hyperslab of a dataset into a preallocated array. Only the selected
+ * elements are read from the file, packed contiguously into the array, i.e. the
+ * array must hold count[i] * block[i] elements in each dimension.
  * @param locationID The parent location that contains the dataset to read
  * @param datasetName The name of the dataset to read
- * @param data A std::vector<T>. Note the vector WILL be resized to fit the data.
- * The best idea is to just allocate the vector but not to size it. The method
- * will size it for you.
+ * @param rank The number of elements in start, stride, count and block. Must match the rank of the dataset.
+ * @param start The offset of the starting element in each dimension
+ * @param stride The number of elements to move in each dimension. May be nullptr
+ * @param count The number of blocks to read in each dimension
+ * @param block The size of a block in each dimension. May be nullptr
+ * @param data A Pointer to the PreAllocated Array of Data
  * @return Standard HDF error condition
  */
 template <typename T>
-inline herr_t readVectorDataset(hid_t locationID, const std::string& datasetName, std::vector<T>& data)
+inline herr_t readPointerHyperslab(hid_t locationID, const std::string& datasetName, int32_t rank, const hsize_t* start, const hsize_t* stride, const hsize_t* count, const hsize_t* block, T* data)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t datasetID;
-  herr_t error = 0;
   herr_t returnError = 0;
-  hid_t spaceId;
   hid_t dataType = HDFTypeForPrimitive<T>();
   if(dataType == -1)
   {
     return -1;
   }
-  datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT);
-  if(datasetID < 0)
+  if(nullptr == data || nullptr == start || nullptr == count)
   {
-    std::cout << "H5Lite.h::readVectorDataset(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    std::cout << "The Pointer to hold the data and the start and count arrays must not be nullptr." << std::endl;
+    return -3;
+  }
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
+  {
+    std::cout << "H5Lite.h::readPointerHyperslab(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
     return -1;
   }
-  if(datasetID >= 0)
+  DataspaceHandle fileSpace;
+  DataspaceHandle memSpace;
+  herr_t error = detail::createHyperslabDataspaces(dataset.get(), rank, start, stride, count, block, fileSpace, memSpace);
+  if(error < 0)
   {
-    spaceId = H5Dget_space(datasetID);
-    if(spaceId > 0)
-    {
-      int32_t rank = H5Sget_simple_extent_ndims(spaceId);
-      if(rank > 0)
-      {
-        std::vector<hsize_t> dims(rank, 0); // Allocate enough room for the dims
-        error = H5Sget_simple_extent_dims(spaceId, dims.data(), nullptr);
-        hsize_t numElements = std::accumulate(dims.cbegin(), dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
-        // std::cout << "NumElements: " << numElements << std::endl;
-        // Resize the vector
-        data.resize(numElements);
-        error = H5Dread(datasetID, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
-        if(error < 0)
-        {
-          std::cout << "Error Reading Data.'" << datasetName << "'" << std::endl;
-          returnError = error;
-        }
-      }
-      error = H5Sclose(spaceId);
-      if(error < 0)
-      {
-        std::cout << "Error Closing Data Space" << std::endl;
-        returnError = error;
-      }
-    }
-    else
-    {
-      std::cout << "Error Opening SpaceID" << std::endl;
-      returnError = static_cast<herr_t>(spaceId);
-    }
-    error = H5Dclose(datasetID);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Dataset" << std::endl;
-      returnError = error;
-    }
+    return error;
+  }
+  error = H5Dread(dataset.get(), dataType, memSpace.get(), fileSpace.get(), H5P_DEFAULT, data);
+  if(error < 0)
+  {
+    std::cout << "Error Reading Hyperslab from '" << datasetName << "'" << std::endl;
+    returnError = error;
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
   }
   return returnError;
 }
 
+/**
+ * @brief Reads a hyperslab of a dataset into a preallocated array. start, stride, count and block
+ * must hold as many elements as the dataset has dimensions since they can not be checked.
+ * Prefer the overload that takes the rank.
+ */
+template <typename T>
+inline herr_t readPointerHyperslab(hid_t locationID, const std::string& datasetName, const hsize_t* start, const hsize_t* stride, const hsize_t* count, const hsize_t* block, T* data)
+{
+  return readPointerHyperslab(locationID, datasetName, -1, start, stride, count, block, data);
+}
+
+/**
+ * @brief Reads a hyperslab of a dataset into a std::vector<T>. The vector WILL be
+ * resized to hold the selected elements.
+ * @param locationID The parent location that contains the dataset to read
+ * @param datasetName The name of the dataset to read
+ * @param start The offset of the starting element in each dimension
+ * @param stride The number of elements to move in each dimension. Empty for a stride of 1
+ * @param count The number of blocks to read in each dimension
+ * @param block The size of a block in each dimension. Empty for a block of 1
+ * @param data The std::vector to hold the data
+ * @return Standard HDF error condition
+ */
+template <typename T>
+inline herr_t readVectorHyperslab(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& start, const std::vector<hsize_t>& stride, const std::vector<hsize_t>& count,
+                                  const std::vector<hsize_t>& block, std::vector<T>& data)
+{
+  if(start.size() != count.size() || (!stride.empty() && stride.size() != start.size()) || (!block.empty() && block.size() != start.size()))
+  {
+    std::cout << "H5Lite.h::readVectorHyperslab(" << __LINE__ << ") The start, stride, count and block vectors must have the same size" << std::endl;
+    return -3;
+  }
+  data.resize(detail::getHyperslabNumElements(count, block));
+  return readPointerHyperslab(locationID, datasetName, static_cast<int32_t>(start.size()), start.data(), stride.empty() ? nullptr : stride.data(), count.data(), block.empty() ? nullptr : block.data(), data.data());
+}
+
+/**
+ * @brief Reads a contiguous hyperslab (stride and block of 1) of a dataset into a std::vector<T>.
+ * The vector WILL be resized to hold the selected elements.
+ *
+ * For example, reading the Z slice 'z' out of a volume with dims {Z, Y, X}:
+ * <code>
+ * std::vector<float> slice;
+ * H5Lite::readVectorHyperslab(fileID, "Volume", {z, 0, 0}, {1, Y, X}, slice);
+ * </code>
+ * @param locationID The parent location that contains the dataset to read
+ * @param datasetName The name of the dataset to read
+ * @param start The offset of the starting element in each dimension
+ * @param count The number of elements to read in each dimension
+ * @param data The std::vector to hold the data
+ * @return Standard HDF error condition
+ */
+template <typename T>
+inline herr_t readVectorHyperslab(hid_t locationID, const std::string& datasetName, const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, std::vector<T>& data)
+{
+  return readVectorHyperslab(locationID, datasetName, start, {}, count, {}, data);
+}
+
 /**
  * @brief Reads a dataset that consists of a single scalar value
  * @param locationID The HDF5 file or group id
@@ -1786,14 +3075,12 @@ inline herr_t readVectorDataset(hid_t locationID, const std::string& datasetName
  * @return HDF error condition.
  */
 template <typename T>
-inline herr_t readScalarDataset(hid_t locationID, const std::string& datasetName, T& data)
+inline herr_t readScalarDataset(hid_t locationID, const char* datasetName, T& data)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t datasetID = 0;
   herr_t error = 0;
   herr_t returnError = 0;
-  hid_t spaceId = 0;
 
   hid_t dataType = HDFTypeForPrimitive<T>();
   if(dataType == -1)
@@ -1801,45 +3088,36 @@ inline herr_t readScalarDataset(hid_t locationID, const std::string& datasetName
     return -1;
   }
   /* Open the dataset. */
-  datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT);
-  if(datasetID < 0)
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
   {
     std::cout << "H5Lite.h::readScalarDataset(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
     return -1;
   }
-  if(datasetID >= 0)
+  error = H5Dread(dataset.get(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data);
+  if(error < 0)
   {
-    spaceId = H5Dget_space(datasetID);
-    if(spaceId > 0)
-    {
-      error = H5Dread(datasetID, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data);
-      if(error < 0)
-      {
-        std::cout << "Error Reading Data at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
-        returnError = error;
-      }
-
-      error = H5Sclose(spaceId);
-      if(error < 0)
-      {
-        std::cout << "Error Closing Data Space at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
-        returnError = error;
-      }
-    }
-    else
-    {
-      returnError = static_cast<herr_t>(spaceId);
-    }
-    error = H5Dclose(datasetID);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
-      returnError = error;
-    }
+    std::cout << "Error Reading Data at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    returnError = error;
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    returnError = error;
   }
   return returnError;
 }
 
+/**
+ * @brief std::string overload of readScalarDataset
+ */
+template <typename T>
+inline herr_t readScalarDataset(hid_t locationID, const std::string& datasetName, T& data)
+{
+  return readScalarDataset(locationID, datasetName.c_str(), data);
+}
+
 /**
  * @brief Reads a dataset of multiple strings into a std::vector<std::string>
  * @param locationID
@@ -1851,12 +3129,10 @@ inline herr_t readVectorOfStringDataset(hid_t locationID, const std::string& dat
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t datasetID; // dataset id
-  hid_t typeID;    // type id
   herr_t returnError = 0;
 
-  datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT);
-  if(datasetID < 0)
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
   {
     std::cout << "H5Lite.cpp::readVectorOfStringDataset(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
     return -1;
@@ -1864,20 +3140,17 @@ inline herr_t readVectorOfStringDataset(hid_t locationID, const std::string& dat
   /*
    * Get the datatype.
    */
-  typeID = H5Dget_type(datasetID);
-  if(typeID >= 0)
+  TypeHandle fileType(H5Dget_type(dataset.get()));
+  if(fileType.isValid())
   {
     hsize_t dims[1] = {0};
     /*
      * Get dataspace and allocate memory for read buffer.
      */
-    hid_t dataspaceID = H5Dget_space(datasetID);
-    int nDims = H5Sget_simple_extent_dims(dataspaceID, dims, nullptr);
+    DataspaceHandle dataspace(H5Dget_space(dataset.get()));
+    int nDims = H5Sget_simple_extent_dims(dataspace.get(), dims, nullptr);
     if(nDims != 1)
     {
-      CloseH5S(dataspaceID, error, returnError);
-      CloseH5T(typeID, error, returnError);
-      CloseH5D(datasetID, error, returnError, datasetName);
       std::cout << "H5Lite.cpp::readVectorOfStringDataset(" << __LINE__ << ") Number of dims should be 1 but it was " << nDims << ". Returning early. Is your data file correct?" << std::endl;
       return -2;
     }
@@ -1887,23 +3160,17 @@ inline herr_t readVectorOfStringDataset(hid_t locationID, const std::string& dat
     /*
      * Create the memory datatype.
      */
-    hid_t memtype = H5Tcopy(H5T_C_S1);
-    herr_t status = H5Tset_size(memtype, H5T_VARIABLE);
-
-    H5T_cset_t characterSet = H5Tget_cset(typeID);
-    status = H5Tset_cset(memtype, characterSet);
+    TypeHandle memType(H5Tcopy(H5T_C_S1));
+    H5Tset_size(memType.get(), H5T_VARIABLE);
+    H5Tset_cset(memType.get(), H5Tget_cset(fileType.get()));
 
     /*
      * Read the data.
      */
-    status = H5Dread(datasetID, memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, rData.data());
+    herr_t status = H5Dread(dataset.get(), memType.get(), H5S_ALL, H5S_ALL, H5P_DEFAULT, rData.data());
     if(status < 0)
     {
-      status = H5Dvlen_reclaim(memtype, dataspaceID, H5P_DEFAULT, rData.data());
-      CloseH5S(dataspaceID, error, returnError);
-      CloseH5T(typeID, error, returnError);
-      CloseH5T(memtype, error, returnError);
-      CloseH5D(datasetID, error, returnError, datasetName);
+      H5Dvlen_reclaim(memType.get(), dataspace.get(), H5P_DEFAULT, rData.data());
       std::cout << "H5Lite.cpp::readVectorOfStringDataset(" << __LINE__ << ") Error reading Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
       return -3;
     }
@@ -1913,23 +3180,23 @@ inline herr_t readVectorOfStringDataset(hid_t locationID, const std::string& dat
     data.resize(dims[0]);
     for(size_t i = 0; i < dims[0]; i++)
     {
-      // printf("%s[%d]: %s\n", "VlenStrings", i, rData[i].p);
       data[i] = std::string(rData[i]);
     }
     /*
-     * Close and release resources.  Note that H5Dvlen_reclaim works
+     * Release resources.  Note that H5Dvlen_reclaim works
      * for variable-length strings as well as variable-length arrays.
      * Also note that we must still free the array of pointers stored
      * in rData, as H5Tvlen_reclaim only frees the data these point to.
      */
-    status = H5Dvlen_reclaim(memtype, dataspaceID, H5P_DEFAULT, rData.data());
-    CloseH5S(dataspaceID, error, returnError);
-    CloseH5T(typeID, error, returnError);
-    CloseH5T(memtype, error, returnError);
+    H5Dvlen_reclaim(memType.get(), dataspace.get(), H5P_DEFAULT, rData.data());
   }
 
-  CloseH5D(datasetID, error, returnError, datasetName);
-
+  herr_t error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
+  }
   return returnError;
 }
 
@@ -1945,14 +3212,11 @@ inline herr_t readStringDataset(hid_t locationID, const std::string& datasetName
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t datasetID; // dataset id
-  hid_t typeID;    // type id
   herr_t error = 0;
   herr_t returnError = 0;
-  hsize_t size;
   data.clear();
-  datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT);
-  if(datasetID < 0)
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
   {
     std::cout << "H5Lite.cpp::readStringDataset(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
     return -1;
@@ -1960,10 +3224,10 @@ inline herr_t readStringDataset(hid_t locationID, const std::string& datasetName
   /*
    * Get the datatype.
    */
-  typeID = H5Dget_type(datasetID);
-  if(typeID >= 0)
+  TypeHandle dataType(H5Dget_type(dataset.get()));
+  if(dataType.isValid())
   {
-    htri_t isVariableString = H5Tis_variable_str(typeID); // Test if the string is variable length
+    htri_t isVariableString = H5Tis_variable_str(dataType.get()); // Test if the string is variable length
 
     if(isVariableString == 1)
     {
@@ -1981,9 +3245,9 @@ inline herr_t readStringDataset(hid_t locationID, const std::string& datasetName
     }
     else
     {
-      size = H5Dget_storage_size(datasetID);
+      hsize_t size = H5Dget_storage_size(dataset.get());
       std::vector<char> buffer(static_cast<size_t>(size + 1), 0x00); // Allocate and Zero and array
-      error = H5Dread(datasetID, typeID, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer.data());
+      error = H5Dread(dataset.get(), dataType.get(), H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer.data());
       if(error < 0)
       {
         std::cout << "Error Reading string dataset." << std::endl;
@@ -1995,8 +3259,16 @@ inline herr_t readStringDataset(hid_t locationID, const std::string& datasetName
       }
     }
   }
-  CloseH5D(datasetID, error, returnError, datasetName);
-  CloseH5T(typeID, error, returnError);
+  else
+  {
+    returnError = static_cast<herr_t>(dataType.get());
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
+  }
   return returnError;
 }
 
@@ -2012,29 +3284,34 @@ inline herr_t readStringDataset(hid_t locationID, const std::string& datasetName
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t datasetID; // dataset id
-  hid_t typeID;    // type id
-  herr_t error = 0;
   herr_t returnError = 0;
 
-  datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT);
-  if(datasetID < 0)
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
   {
     std::cout << "H5Lite.cpp::readStringDataset(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
     return -1;
   }
-  typeID = H5Dget_type(datasetID);
-  if(typeID >= 0)
+  TypeHandle dataType(H5Dget_type(dataset.get()));
+  if(dataType.isValid())
   {
-    error = H5Dread(datasetID, typeID, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    herr_t error = H5Dread(dataset.get(), dataType.get(), H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
     if(error < 0)
     {
       std::cout << "Error Reading string dataset." << std::endl;
       returnError = error;
     }
-    CloseH5T(typeID, error, returnError);
   }
-  CloseH5D(datasetID, error, returnError, datasetName);
+  else
+  {
+    returnError = static_cast<herr_t>(dataType.get());
+  }
+  herr_t error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
+  }
   return returnError;
 }
 
@@ -2056,79 +3333,61 @@ inline herr_t getAttributeInfo(hid_t locationID, const std::string& objectName,
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  /* identifiers */
-  hid_t objectID;
   H5O_info_t objectInfo{};
-  hid_t attributeID;
   herr_t error = 0;
   herr_t returnError = 0;
-  hid_t dataspaceID;
-  hid_t rank = -1;
 
-  error = H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT);
-  if(error < 0)
+  /* Open the object */
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectInfo.type));
+  if(!object.isValid())
+  {
+    return static_cast<herr_t>(object.get());
+  }
+  AttributeHandle attribute(H5Aopen(object.get(), attributeName.c_str(), H5P_DEFAULT));
+  if(!attribute.isValid())
   {
-    return error;
+    return -1;
   }
-
-  /* Open the object */
-  objectID = openId(locationID, objectName, objectInfo.type);
-  if(objectID >= 0)
+  /* Get an identifier for the datatype. */
+  typeID = H5Aget_type(attribute.get());
+  if(typeID > 0)
   {
-    attributeID = H5Aopen_by_name(locationID, objectName.c_str(), attributeName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
-    if(attributeID >= 0)
+    /* Get the class. */
+    typeClass = H5Tget_class(typeID);
+    /* Get the size. */
+    typeSize = H5Tget_size(typeID);
+    DataspaceHandle dataspace(H5Aget_space(attribute.get()));
+    if(dataspace.isValid())
     {
-      /* Get an identifier for the datatype. */
-      typeID = H5Aget_type(attributeID);
-      if(typeID > 0)
+      if(typeClass == H5T_STRING)
+      {
+        dims.resize(1);
+        dims[0] = typeSize;
+      }
+      else
       {
-        /* Get the class. */
-        typeClass = H5Tget_class(typeID);
-        /* Get the size. */
-        typeSize = H5Tget_size(typeID);
-        dataspaceID = H5Aget_space(attributeID);
-        if(dataspaceID >= 0)
+        int32_t rank = H5Sget_simple_extent_ndims(dataspace.get());
+        std::vector<hsize_t> _dims(rank, 0);
+        /* Get dimensions */
+        error = H5Sget_simple_extent_dims(dataspace.get(), _dims.data(), nullptr);
+        if(error < 0)
         {
-          if(typeClass == H5T_STRING)
-          {
-            rank = 1;
-            dims.resize(rank);
-            dims[0] = typeSize;
-          }
-          else
-          {
-            rank = H5Sget_simple_extent_ndims(dataspaceID);
-            std::vector<hsize_t> _dims(rank, 0);
-            /* Get dimensions */
-            error = H5Sget_simple_extent_dims(dataspaceID, _dims.data(), nullptr);
-            if(error < 0)
-            {
-              std::cout << "Error Getting Attribute dims" << std::endl;
-              returnError = error;
-            }
-            // Copy the dimensions into the dims vector
-            dims.clear(); // Erase everything in the Vector
-            dims.resize(rank);
-            std::copy(_dims.cbegin(), _dims.cend(), dims.begin());
-          }
-          CloseH5S(dataspaceID, error, returnError);
-          dataspaceID = 0;
+          std::cout << "Error Getting Attribute dims" << std::endl;
+          returnError = error;
         }
+        // Copy the dimensions into the dims vector
+        dims.clear(); // Erase everything in the Vector
+        dims.resize(rank);
+        std::copy(_dims.cbegin(), _dims.cend(), dims.begin());
       }
-      CloseH5A(attributeID, error, returnError);
-      attributeID = 0;
-    }
-    else
-    {
-      returnError = -1;
-    }
-    error = closeId(objectID, objectInfo.type);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Object ID" << std::endl;
-      returnError = error;
     }
   }
+  error = attribute.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Attribute" << std::endl;
+    returnError = error;
+  }
   return returnError;
 }
 
@@ -2149,63 +3408,45 @@ inline herr_t readVectorAttribute(hid_t locationID, const std::string& objectNam
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  /* identifiers */
-  hid_t objectID;
   H5O_info_t objectInfo;
   herr_t error = 0;
   herr_t returnError = 0;
-  hid_t attributeID;
-  hid_t typeID;
   hid_t dataType = HDFTypeForPrimitive<T>();
   if(dataType == -1)
   {
     return -1;
   }
-  // std::cout << "   Reading Vector Attribute at Path '" << objectName << "' with Key: '" << attributeName << "'" << std::endl;
-  /* Get the type of object */
-  error = H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT);
+  /* Open the object */
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectInfo.type));
+  if(!object.isValid())
+  {
+    return static_cast<herr_t>(object.get());
+  }
+  AttributeHandle attribute(H5Aopen(object.get(), attributeName.c_str(), H5P_DEFAULT));
+  if(!attribute.isValid())
+  {
+    return static_cast<herr_t>(attribute.get());
+  }
+  // Need to allocate the array size
+  DataspaceHandle dataspace(H5Aget_space(attribute.get()));
+  hssize_t numElements = dataspace.isValid() ? H5Sget_simple_extent_npoints(dataspace.get()) : -1;
+  if(numElements < 0)
+  {
+    std::cout << "Error Getting Attribute dims" << std::endl;
+    return -1;
+  }
+  data.resize(static_cast<size_t>(numElements));
+  error = H5Aread(attribute.get(), dataType, data.data());
   if(error < 0)
   {
-    return error;
+    std::cout << "Error Reading Attribute." << error << std::endl;
+    returnError = error;
   }
-  /* Open the object */
-  objectID = openId(locationID, objectName, objectInfo.type);
-  if(objectID >= 0)
+  error = attribute.close();
+  if(error < 0)
   {
-    attributeID = H5Aopen_by_name(locationID, objectName.c_str(), attributeName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
-    if(attributeID >= 0)
-    {
-      // Need to allocate the array size
-      H5T_class_t typeClass;
-      size_t typeSize;
-      std::vector<hsize_t> dims;
-      error = getAttributeInfo(locationID, objectName, attributeName, dims, typeClass, typeSize, typeID);
-      hsize_t numElements = std::accumulate(dims.cbegin(), dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
-      // std::cout << "    Vector Attribute has " << numElements << " elements." << std::endl;
-      data.resize(numElements);
-      error = H5Aread(attributeID, dataType, data.data());
-      if(error < 0)
-      {
-        std::cout << "Error Reading Attribute." << error << std::endl;
-        returnError = error;
-      }
-      error = H5Aclose(attributeID);
-      if(error < 0)
-      {
-        std::cout << "Error Closing Attribute" << std::endl;
-        returnError = error;
-      }
-    }
-    else
-    {
-      returnError = static_cast<herr_t>(attributeID);
-    }
-    error = closeId(objectID, objectInfo.type);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Object" << std::endl;
-      returnError = error;
-    }
+    std::cout << "Error Closing Attribute" << std::endl;
+    returnError = error;
   }
   return returnError;
 }
@@ -2218,7 +3459,7 @@ inline herr_t readVectorAttribute(hid_t locationID, const std::string& objectNam
  * @return Standard HDF5 error condition
  */
 template <typename T>
-inline herr_t readScalarAttribute(hid_t locationID, const std::string& attributeName, T& data)
+inline herr_t readScalarAttribute(hid_t locationID, const char* attributeName, T& data)
 {
   H5SUPPORT_MUTEX_LOCK()
 
@@ -2229,30 +3470,35 @@ inline herr_t readScalarAttribute(hid_t locationID, const std::string& attribute
     return -1;
   }
 
-  hid_t attributeID = H5Aopen(locationID, attributeName.c_str(), H5P_DEFAULT);
-  if(attributeID >= 0)
+  AttributeHandle attribute(H5Aopen(locationID, attributeName, H5P_DEFAULT));
+  if(!attribute.isValid())
   {
-    herr_t error = H5Aread(attributeID, dataType, &data);
-    if(error < 0)
-    {
-      std::cout << "Error Reading Attribute." << std::endl;
-      returnError = error;
-    }
-    error = H5Aclose(attributeID);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Attribute" << std::endl;
-      returnError = error;
-    }
+    return static_cast<herr_t>(attribute.get());
   }
-  else
+  herr_t error = H5Aread(attribute.get(), dataType, &data);
+  if(error < 0)
   {
-    returnError = static_cast<herr_t>(attributeID);
+    std::cout << "Error Reading Attribute." << std::endl;
+    returnError = error;
+  }
+  error = attribute.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Attribute" << std::endl;
+    returnError = error;
   }
-
   return returnError;
 }
 
+/**
+ * @brief std::string overload of readScalarAttribute
+ */
+template <typename T>
+inline herr_t readScalarAttribute(hid_t locationID, const std::string& attributeName, T& data)
+{
+  return readScalarAttribute(locationID, attributeName.c_str(), data);
+}
+
 /**
  * @brief Reads a scalar attribute value from a dataset
  * @param locationID
@@ -2262,62 +3508,53 @@ inline herr_t readScalarAttribute(hid_t locationID, const std::string& attribute
  * @return Standard HDF5 error condition
  */
 template <typename T>
-inline herr_t readScalarAttribute(hid_t locationID, const std::string& objectName, const std::string& attributeName, T& data)
+inline herr_t readScalarAttribute(hid_t locationID, const char* objectName, const char* attributeName, T& data)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  /* identifiers */
-  hid_t objectID;
   H5O_info_t objectInfo;
   herr_t error = 0;
   herr_t returnError = 0;
-  hid_t attributeID;
   hid_t dataType = HDFTypeForPrimitive<T>();
   if(dataType == -1)
   {
     return -1;
   }
-  // std::cout << "Reading Scalar style Attribute at Path '" << objectName << "' with Key: '" << attributeName << "'" << std::endl;
-  /* Get the type of object */
-  error = H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT);
+  /* Open the object */
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectInfo.type));
+  if(!object.isValid())
+  {
+    return static_cast<herr_t>(object.get());
+  }
+  AttributeHandle attribute(H5Aopen(object.get(), attributeName, H5P_DEFAULT));
+  if(!attribute.isValid())
+  {
+    return static_cast<herr_t>(attribute.get());
+  }
+  error = H5Aread(attribute.get(), dataType, &data);
   if(error < 0)
   {
-    return error;
+    std::cout << "Error Reading Attribute." << error << std::endl;
+    returnError = error;
   }
-  /* Open the object */
-  objectID = openId(locationID, objectName, objectInfo.type);
-  if(objectID >= 0)
+  error = attribute.close();
+  if(error < 0)
   {
-    attributeID = H5Aopen_by_name(locationID, objectName.c_str(), attributeName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
-    if(attributeID >= 0)
-    {
-      error = H5Aread(attributeID, dataType, &data);
-      if(error < 0)
-      {
-        std::cout << "Error Reading Attribute." << std::endl;
-        returnError = error;
-      }
-      error = H5Aclose(attributeID);
-      if(error < 0)
-      {
-        std::cout << "Error Closing Attribute" << std::endl;
-        returnError = error;
-      }
-    }
-    else
-    {
-      returnError = static_cast<herr_t>(attributeID);
-    }
-    error = closeId(objectID, objectInfo.type);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Object" << std::endl;
-      returnError = error;
-    }
+    std::cout << "Error Closing Attribute" << std::endl;
+    returnError = error;
   }
   return returnError;
 }
 
+/**
+ * @brief std::string overload of readScalarAttribute
+ */
+template <typename T>
+inline herr_t readScalarAttribute(hid_t locationID, const std::string& objectName, const std::string& attributeName, T& data)
+{
+  return readScalarAttribute(locationID, objectName.c_str(), attributeName.c_str(), data);
+}
+
 /**
  * @brief Reads the Attribute into a pre-allocated pointer
  * @param locationID
@@ -2327,62 +3564,53 @@ inline herr_t readScalarAttribute(hid_t locationID, const std::string& objectNam
  * @return Standard HDF5 error condition
  */
 template <typename T>
-inline herr_t readPointerAttribute(hid_t locationID, const std::string& objectName, const std::string& attributeName, T* data)
+inline herr_t readPointerAttribute(hid_t locationID, const char* objectName, const char* attributeName, T* data)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  /* identifiers */
-  hid_t objectID;
   H5O_info_t objectInfo;
   herr_t error = 0;
   herr_t returnError = 0;
-  hid_t attributeID;
   hid_t dataType = HDFTypeForPrimitive<T>();
   if(dataType == -1)
   {
     return -1;
   }
-  // std::cout << "   Reading Vector Attribute at Path '" << objectName << "' with Key: '" << attributeName << "'" << std::endl;
-  /* Get the type of object */
-  error = H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT);
+  /* Open the object */
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectInfo.type));
+  if(!object.isValid())
+  {
+    return static_cast<herr_t>(object.get());
+  }
+  AttributeHandle attribute(H5Aopen(object.get(), attributeName, H5P_DEFAULT));
+  if(!attribute.isValid())
+  {
+    return static_cast<herr_t>(attribute.get());
+  }
+  error = H5Aread(attribute.get(), dataType, data);
   if(error < 0)
   {
-    return error;
+    std::cout << "Error Reading Attribute." << error << std::endl;
+    returnError = error;
   }
-  /* Open the object */
-  objectID = openId(locationID, objectName, objectInfo.type);
-  if(objectID >= 0)
+  error = attribute.close();
+  if(error < 0)
   {
-    attributeID = H5Aopen_by_name(locationID, objectName.c_str(), attributeName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
-    if(attributeID >= 0)
-    {
-      error = H5Aread(attributeID, dataType, data);
-      if(error < 0)
-      {
-        std::cout << "Error Reading Attribute." << error << std::endl;
-        returnError = error;
-      }
-      error = H5Aclose(attributeID);
-      if(error < 0)
-      {
-        std::cout << "Error Closing Attribute" << std::endl;
-        returnError = error;
-      }
-    }
-    else
-    {
-      returnError = static_cast<herr_t>(attributeID);
-    }
-    error = closeId(objectID, objectInfo.type);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Object" << std::endl;
-      returnError = error;
-    }
+    std::cout << "Error Closing Attribute" << std::endl;
+    returnError = error;
   }
   return returnError;
 }
 
+/**
+ * @brief std::string overload of readPointerAttribute
+ */
+template <typename T>
+inline herr_t readPointerAttribute(hid_t locationID, const std::string& objectName, const std::string& attributeName, T* data)
+{
+  return readPointerAttribute(locationID, objectName.c_str(), attributeName.c_str(), data);
+}
+
 /**
  * @brief Reads a string attribute from an HDF object
  * @param locationID The Parent object that holds the object to which you want to read an attribute
@@ -2396,43 +3624,36 @@ inline herr_t readStringAttribute(hid_t locationID, const std::string& attribute
 
   data.clear();
 
-  hid_t attributeID = H5Aopen(locationID, attributeName.c_str(), H5P_DEFAULT);
-  if(attributeID < 0)
+  AttributeHandle attribute(H5Aopen(locationID, attributeName.c_str(), H5P_DEFAULT));
+  if(!attribute.isValid())
   {
-    return static_cast<herr_t>(attributeID);
+    return static_cast<herr_t>(attribute.get());
   }
-
-  hid_t attributeType = H5Aget_type(attributeID);
-  if(attributeType < 0)
+  TypeHandle attributeType(H5Aget_type(attribute.get()));
+  if(!attributeType.isValid())
   {
-    H5Aclose(attributeID);
-    return static_cast<herr_t>(attributeType);
+    return static_cast<herr_t>(attributeType.get());
   }
 
-  if(H5Tis_variable_str(attributeType) > 0)
+  if(H5Tis_variable_str(attributeType.get()) > 0)
   {
-    hid_t space = H5Aget_space(attributeID);
-    int32_t ndims = H5Sget_simple_extent_ndims(space);
+    DataspaceHandle space(H5Aget_space(attribute.get()));
+    int32_t ndims = H5Sget_simple_extent_ndims(space.get());
     size_t size = 1;
     if(ndims > 0)
     {
       std::vector<hsize_t> dims(ndims, 0);
-      H5Sget_simple_extent_dims(space, dims.data(), nullptr);
+      H5Sget_simple_extent_dims(space.get(), dims.data(), nullptr);
       size = std::accumulate(dims.cbegin(), dims.cend(), static_cast<size_t>(0));
     }
     std::vector<char*> rData(size, nullptr);
 
-    hid_t memtype = H5Tcopy(H5T_C_S1);
-    herr_t error = H5Tset_size(memtype, H5T_VARIABLE);
-    H5T_cset_t characterSet = H5Tget_cset(attributeType);
-    error = H5Tset_cset(memtype, characterSet);
-    error = H5Aread(attributeID, memtype, rData.data());
+    TypeHandle memType(H5Tcopy(H5T_C_S1));
+    H5Tset_size(memType.get(), H5T_VARIABLE);
+    H5Tset_cset(memType.get(), H5Tget_cset(attributeType.get()));
+    herr_t error = H5Aread(attribute.get(), memType.get(), rData.data());
     if(error < 0)
     {
-      H5Sclose(space);
-      H5Tclose(memtype);
-      H5Tclose(attributeType);
-      H5Aclose(attributeID);
       return error;
     }
 
@@ -2441,19 +3662,15 @@ inline herr_t readStringAttribute(hid_t locationID, const std::string& attribute
       data.append(ptr);
     }
 
-    error = H5Dvlen_reclaim(memtype, space, H5P_DEFAULT, rData.data());
-    H5Sclose(space);
-    H5Tclose(memtype);
+    H5Dvlen_reclaim(memType.get(), space.get(), H5P_DEFAULT, rData.data());
   }
   else
   {
-    hsize_t size = H5Aget_storage_size(attributeID);
+    hsize_t size = H5Aget_storage_size(attribute.get());
     std::vector<char> attributeOutput(size);
-    herr_t error = H5Aread(attributeID, attributeType, attributeOutput.data());
+    herr_t error = H5Aread(attribute.get(), attributeType.get(), attributeOutput.data());
     if(error < 0)
     {
-      H5Tclose(attributeType);
-      H5Aclose(attributeID);
       return error;
     }
     if(attributeOutput[size - 1] == 0)
@@ -2463,9 +3680,6 @@ inline herr_t readStringAttribute(hid_t locationID, const std::string& attribute
     data.append(attributeOutput.data(), size);
   }
 
-  H5Tclose(attributeType);
-  H5Aclose(attributeID);
-
   return 0;
 }
 
@@ -2481,77 +3695,53 @@ inline herr_t readStringAttribute(hid_t locationID, const std::string& objectNam
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  /* identifiers */
-  hid_t objectID;
   H5O_info_t objectInfo{};
-  hid_t attributeID;
-  hid_t attributeType;
-  std::vector<char> attributeOutput;
-  hsize_t size;
-  herr_t error = 0;
   herr_t returnError = 0;
   data.clear();
-  HDF_ERROR_HANDLER_OFF;
+  H5ScopedErrorHandler errorHandler;
 
-  /* Get the type of object */
-  error = H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT);
+  /* Open the object */
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectInfo.type));
+  if(!object.isValid())
+  {
+    return static_cast<herr_t>(object.get());
+  }
+  AttributeHandle attribute(H5Aopen(object.get(), attributeName.c_str(), H5P_DEFAULT));
+  if(!attribute.isValid())
+  {
+    return 0;
+  }
+  TypeHandle attributeType(H5Aget_type(attribute.get()));
+  if(!attributeType.isValid())
+  {
+    return static_cast<herr_t>(attributeType.get());
+  }
+  if(H5Tis_variable_str(attributeType.get()) == 1) // Variable length strings are read by readStringAttribute(objectID, ...)
+  {
+    return -1;
+  }
+  hsize_t size = H5Aget_storage_size(attribute.get());
+  std::vector<char> attributeOutput(static_cast<size_t>(size)); // Resize the vector to the proper length
+  herr_t error = H5Aread(attribute.get(), attributeType.get(), attributeOutput.data());
   if(error < 0)
   {
-    return error;
+    std::cout << "Error Reading Attribute." << std::endl;
+    returnError = error;
   }
-
-  /* Open the object */
-  objectID = openId(locationID, objectName, objectInfo.type);
-  if(objectID >= 0)
+  else
   {
-    attributeID = H5Aopen_by_name(locationID, objectName.c_str(), attributeName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
-    hid_t attrTypeId = H5Aget_type(attributeID);
-    htri_t isVariableString = H5Tis_variable_str(attrTypeId); // Test if the string is variable length
-    H5Tclose(attrTypeId);
-    if(isVariableString == 1)
-    {
-      data.clear();
-      returnError = -1;
-      CloseH5A(attributeID, error, returnError);
-      return returnError;
-    }
-    if(attributeID >= 0)
-    {
-      size = H5Aget_storage_size(attributeID);
-      attributeOutput.resize(static_cast<size_t>(size)); // Resize the vector to the proper length
-      attributeType = H5Aget_type(attributeID);
-      if(attributeType >= 0)
-      {
-        error = H5Aread(attributeID, attributeType, attributeOutput.data());
-        if(error < 0)
-        {
-          std::cout << "Error Reading Attribute." << std::endl;
-          returnError = error;
-        }
-        else
-        {
-          if(attributeOutput[size - 1] == 0) // null Terminated string
-          {
-            size -= 1;
-          }
-          data.append(attributeOutput.data(), size); // Append the data to the passed in string
-        }
-        CloseH5T(attributeType, error, returnError);
-      }
-      CloseH5A(attributeID, error, returnError);
-    }
-    else
-    {
-      // returnError = attributeID;
-    }
-    error = closeId(objectID, objectInfo.type);
-    if(error < 0)
+    if(attributeOutput[size - 1] == 0) // null Terminated string
     {
-      std::cout << "Error Closing Object ID" << std::endl;
-      returnError = error;
+      size -= 1;
     }
+    data.append(attributeOutput.data(), size); // Append the data to the passed in string
+  }
+  error = attribute.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Attribute" << std::endl;
+    returnError = error;
   }
-  HDF_ERROR_HANDLER_ON;
   return returnError;
 }
 
@@ -2567,55 +3757,37 @@ inline herr_t readStringAttribute(hid_t locationID, const std::string& objectNam
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  /* identifiers */
-  hid_t objectID;
   H5O_info_t objectInfo{};
-  hid_t attributeID;
-  hid_t attributeType;
-  herr_t error = 0;
   herr_t returnError = 0;
+  H5ScopedErrorHandler errorHandler;
 
-  HDF_ERROR_HANDLER_OFF;
-
-  /* Get the type of object */
-  error = H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT);
-  if(error < 0)
+  /* Open the object */
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectInfo.type));
+  if(!object.isValid())
   {
-    return error;
+    return static_cast<herr_t>(object.get());
   }
-
-  /* Open the object */
-  objectID = openId(locationID, objectName, objectInfo.type);
-  if(objectID >= 0)
+  AttributeHandle attribute(H5Aopen(object.get(), attributeName.c_str(), H5P_DEFAULT));
+  if(!attribute.isValid())
   {
-    attributeID = H5Aopen_by_name(locationID, objectName.c_str(), attributeName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
-    if(attributeID >= 0)
-    {
-      attributeType = H5Aget_type(attributeID);
-      if(attributeType >= 0)
-      {
-        error = H5Aread(attributeID, attributeType, data);
-        if(error < 0)
-        {
-          std::cout << "Error Reading Attribute." << std::endl;
-          returnError = error;
-        }
-        CloseH5T(attributeType, error, returnError);
-      }
-      CloseH5A(attributeID, error, returnError);
-    }
-    else
-    {
-      // returnError = attributeID;
-    }
-    error = closeId(objectID, objectInfo.type);
+    return 0;
+  }
+  TypeHandle attributeType(H5Aget_type(attribute.get()));
+  if(attributeType.isValid())
+  {
+    herr_t error = H5Aread(attribute.get(), attributeType.get(), data);
     if(error < 0)
     {
-      std::cout << "Error Closing Object ID" << std::endl;
+      std::cout << "Error Reading Attribute." << std::endl;
       returnError = error;
     }
   }
-  HDF_ERROR_HANDLER_ON;
+  herr_t error = attribute.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Attribute" << std::endl;
+    returnError = error;
+  }
   return returnError;
 }
 
@@ -2630,48 +3802,26 @@ inline herr_t getAttributeNDims(hid_t locationID, const std::string& objectName,
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  /* identifiers */
-  hid_t objectID;
   H5O_info_t objectInfo{};
-  hid_t attributeID;
-  herr_t error = 0;
-  herr_t returnError = 0;
-  hid_t dataspaceID;
   rank = -1;
-  /* Get the type of object */
-  error = H5Oget_info_by_name(locationID, objectName.c_str(), &objectInfo, H5P_DEFAULT);
-  if(error < 0)
+  /* Open the object */
+  ObjectHandle object(H5ObjectCache::openObject(locationID, objectName, objectInfo.type));
+  if(!object.isValid())
   {
-    return error;
+    return static_cast<herr_t>(object.get());
   }
-  /* Open the object */
-  objectID = openId(locationID, objectName, objectInfo.type);
-  if(objectID >= 0)
+  AttributeHandle attribute(H5Aopen(object.get(), attributeName.c_str(), H5P_DEFAULT));
+  if(!attribute.isValid())
   {
-    attributeID = H5Aopen_by_name(locationID, objectName.c_str(), attributeName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
-    if(attributeID >= 0)
-    {
-      dataspaceID = H5Aget_space(attributeID);
-      if(dataspaceID >= 0)
-      {
-        rank = H5Sget_simple_extent_ndims(dataspaceID);
-        CloseH5S(dataspaceID, error, returnError);
-      }
-      CloseH5A(attributeID, error, returnError);
-    }
-    else
-    {
-      returnError = static_cast<herr_t>(attributeID);
-    }
-    error = closeId(objectID, objectInfo.type);
-    if(error < 0)
-    {
-      std::cout << "Error Closing Object ID" << std::endl;
-      returnError = error;
-    }
+    return static_cast<herr_t>(attribute.get());
   }
-
-  return returnError;
+  DataspaceHandle dataspace(H5Aget_space(attribute.get()));
+  if(!dataspace.isValid())
+  {
+    return static_cast<herr_t>(dataspace.get());
+  }
+  rank = H5Sget_simple_extent_ndims(dataspace.get());
+  return 0;
 }
 
 /**
@@ -2684,38 +3834,31 @@ inline herr_t getDatasetNDims(hid_t locationID, const std::string& datasetName,
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t datasetID;
-  hid_t dataspaceID;
-  herr_t error = 0;
   herr_t returnError = 0;
   rank = 0;
 
   /* Open the dataset. */
-  if((datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT)) < 0)
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
   {
     return -1;
   }
 
   /* Get the dataspace handle */
-  dataspaceID = H5Dget_space(datasetID);
-  if(dataspaceID >= 0)
+  DataspaceHandle dataspace(H5Dget_space(dataset.get()));
+  if(dataspace.isValid())
   {
-
     /* Get rank */
-    rank = H5Sget_simple_extent_ndims(dataspaceID);
+    rank = H5Sget_simple_extent_ndims(dataspace.get());
     if(rank < 0)
     {
-      // returnError = rank;
       rank = 0;
       std::cout << "Error Getting the rank of the dataset:" << std::endl;
     }
-
-    /* Terminate access to the dataspace */
-    CloseH5S(dataspaceID, error, returnError);
   }
 
   /* End access to the dataset */
-  error = H5Dclose(datasetID);
+  herr_t error = dataset.close();
   if(error < 0)
   {
     returnError = error;
@@ -2736,21 +3879,21 @@ inline herr_t getDatasetNDims(hid_t locationID, const std::string& datasetName,
 inline hid_t getDatasetType(hid_t locationID, const std::string& datasetName)
 {
   H5SUPPORT_MUTEX_LOCK()
-  herr_t returnError = 0;
-  hid_t datasetID = -1;
   /* Open the dataset. */
-  if((datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT)) < 0)
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
   {
     return -1;
   }
   /* Get an identifier for the datatype. */
-  hid_t typeID = H5Dget_type(datasetID);
-  CloseH5D(datasetID, error, returnError, datasetName);
-  if(returnError < 0)
+  TypeHandle type(H5Dget_type(dataset.get()));
+  herr_t error = dataset.close();
+  if(error < 0)
   {
-    return static_cast<hid_t>(returnError);
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    return static_cast<hid_t>(error);
   }
-  return typeID;
+  return type.release();
 }
 
 /**
@@ -2767,46 +3910,36 @@ inline herr_t getDatasetInfo(hid_t locationID, const std::string& datasetName, s
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t datasetID;
-  hid_t typeID;
-  hid_t dataspaceID;
   herr_t error = 0;
   herr_t returnError = 0;
-  hid_t rank = 0;
 
   /* Open the dataset. */
-  if((datasetID = H5Dopen(locationID, datasetName.c_str(), H5P_DEFAULT)) < 0)
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
   {
     return -1;
   }
 
   /* Get an identifier for the datatype. */
-  typeID = H5Dget_type(datasetID);
-  if(typeID >= 0)
+  TypeHandle type(H5Dget_type(dataset.get()));
+  if(type.isValid())
   {
     /* Get the class. */
-    classType = H5Tget_class(typeID);
+    classType = H5Tget_class(type.get());
     /* Get the size. */
-    sizeType = H5Tget_size(typeID);
-    /* Release the datatype. */
-    error = H5Tclose(typeID);
-    if(error < 0)
-    {
-      std::cout << "Error Closing H5Type" << std::endl;
-      returnError = error;
-    }
+    sizeType = H5Tget_size(type.get());
   }
   /* Get the dataspace handle */
-  dataspaceID = H5Dget_space(datasetID);
-  if(dataspaceID >= 0)
+  DataspaceHandle dataspace(H5Dget_space(dataset.get()));
+  if(dataspace.isValid())
   {
     /* Get the Number of Dimensions */
-    rank = H5Sget_simple_extent_ndims(dataspaceID);
+    int32_t rank = H5Sget_simple_extent_ndims(dataspace.get());
     if(rank > 0)
     {
       std::vector<hsize_t> _dims(rank, 0);
       /* Get dimensions */
-      error = H5Sget_simple_extent_dims(dataspaceID, _dims.data(), nullptr);
+      error = H5Sget_simple_extent_dims(dataspace.get(), _dims.data(), nullptr);
       if(error < 0)
       {
         std::cout << "Error Getting Simple Extents for dataset" << std::endl;
@@ -2821,12 +3954,15 @@ inline herr_t getDatasetInfo(hid_t locationID, const std::string& datasetName, s
       dims.clear(); // Erase everything in the Vector
       dims.push_back(sizeType);
     }
-    /* Terminate access to the dataspace */
-    CloseH5S(dataspaceID, error, returnError);
   }
 
   /* End access to the dataset */
-  CloseH5D(datasetID, error, returnError, datasetName);
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset: " << datasetName << std::endl;
+    returnError = error;
+  }
   return returnError;
 }
 
@@ -0,0 +1,355 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hdf5.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define H5Support_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "H5Support/H5Lite.h"
+#include "H5Support/H5Support.h"
+
+namespace H5Support
+{
+
+/**
+ * @brief A read-only, typed view of a whole dataset produced by H5Lite::mapDataset. When the dataset
+ * could be memory mapped the view points straight into the file and pages are loaded on demand;
+ * otherwise the view owns a copy of the data that was read with H5Dread. The view stays valid after
+ * the file is closed.
+ */
+template <typename T>
+class MappedDataset
+{
+public:
+  MappedDataset() = default;
+
+  ~MappedDataset()
+  {
+    reset();
+  }
+
+  MappedDataset(const MappedDataset&) = delete;            // Copy Constructor Not Implemented
+  MappedDataset& operator=(const MappedDataset&) = delete; // Copy Assignment Not Implemented
+
+  MappedDataset(MappedDataset&& other) noexcept
+  {
+    *this = std::move(other);
+  }
+
+  MappedDataset& operator=(MappedDataset&& other) noexcept
+  {
+    if(this != &other)
+    {
+      reset();
+      std::swap(m_Mapping, other.m_Mapping);
+      std::swap(m_MappingSize, other.m_MappingSize);
+      std::swap(m_Data, other.m_Data);
+      std::swap(m_NumElements, other.m_NumElements);
+      m_Copy.swap(other.m_Copy);
+      m_Dims.swap(other.m_Dims);
+    }
+    return *this;
+  }
+
+  const T* data() const
+  {
+    return m_Data;
+  }
+
+  size_t size() const
+  {
+    return m_NumElements;
+  }
+
+  bool empty() const
+  {
+    return m_NumElements == 0;
+  }
+
+  const T& operator[](size_t index) const
+  {
+    return m_Data[index];
+  }
+
+  const T* begin() const
+  {
+    return m_Data;
+  }
+
+  const T* end() const
+  {
+    return m_Data + m_NumElements;
+  }
+
+  const std::vector<hsize_t>& getDims() const
+  {
+    return m_Dims;
+  }
+
+  /**
+   * @brief Returns true if the view points into a memory mapping of the file, false if it holds a copy
+   */
+  bool isMapped() const
+  {
+    return m_Mapping != nullptr;
+  }
+
+  /**
+   * @brief Unmaps or frees the data
+   */
+  void reset()
+  {
+#ifdef H5Support_HAVE_MMAP
+    if(m_Mapping != nullptr)
+    {
+      munmap(m_Mapping, m_MappingSize);
+    }
+#endif
+    m_Mapping = nullptr;
+    m_MappingSize = 0;
+    m_Data = nullptr;
+    m_NumElements = 0;
+    m_Copy.clear();
+    m_Copy.shrink_to_fit();
+    m_Dims.clear();
+  }
+
+  /**
+   * @brief Takes ownership of a mapping. Used by H5Lite::mapDataset.
+   */
+  void setMapping(void* mapping, size_t mappingSize, const T* data, std::vector<hsize_t> dims)
+  {
+    reset();
+    m_Mapping = mapping;
+    m_MappingSize = mappingSize;
+    m_Data = data;
+    m_Dims = std::move(dims);
+    m_NumElements = std::accumulate(m_Dims.cbegin(), m_Dims.cend(), static_cast<size_t>(1), std::multiplies<size_t>());
+  }
+
+  /**
+   * @brief Takes ownership of a copy of the data. Used by H5Lite::mapDataset.
+   */
+  void setCopy(std::vector<T>&& copy, std::vector<hsize_t> dims)
+  {
+    reset();
+    m_Copy = std::move(copy);
+    m_Data = m_Copy.data();
+    m_NumElements = m_Copy.size();
+    m_Dims = std::move(dims);
+  }
+
+private:
+  void* m_Mapping = nullptr;
+  size_t m_MappingSize = 0;
+  const T* m_Data = nullptr;
+  size_t m_NumElements = 0;
+  std::vector<T> m_Copy;
+  std::vector<hsize_t> m_Dims;
+};
+
+namespace H5Lite
+{
+namespace detail
+{
+/**
+ * @brief Memory maps the raw bytes of a dataset if that gives exactly the values H5Dread would return:
+ * the file must be opened read-only with the sec2 driver and the dataset must be contiguous, allocated,
+ * unfiltered, stored in the file itself and of the same (native) type and byte order as T.
+ * @return True if the dataset was mapped
+ */
+template <typename T>
+inline bool mapContiguousDataset(hid_t datasetID, const std::vector<hsize_t>& dims, MappedDataset<T>& view)
+{
+#ifdef H5Support_HAVE_MMAP
+  const size_t numElements = std::accumulate(dims.cbegin(), dims.cend(), static_cast<size_t>(1), std::multiplies<size_t>());
+  if(numElements == 0)
+  {
+    return false;
+  }
+
+  bool mappable = false;
+  PropertyListHandle propertyList(H5Dget_create_plist(datasetID));
+  if(propertyList.isValid())
+  {
+    mappable = H5Pget_layout(propertyList.get()) == H5D_CONTIGUOUS && H5Pget_nfilters(propertyList.get()) == 0 && H5Pget_external_count(propertyList.get()) == 0;
+  }
+  TypeHandle type(H5Dget_type(datasetID));
+  mappable = mappable && type.isValid() && H5Tequal(type.get(), HDFTypeForPrimitive<T>()) > 0;
+  haddr_t offset = H5Dget_offset(datasetID);
+  mappable = mappable && offset != HADDR_UNDEF && H5Dget_storage_size(datasetID) == numElements * sizeof(T);
+  if(!mappable)
+  {
+    return false;
+  }
+
+  FileHandle file(H5Iget_file_id(datasetID));
+  if(!file.isValid())
+  {
+    return false;
+  }
+  uint32_t intent = 0;
+  mappable = H5Fget_intent(file.get(), &intent) >= 0 && intent == H5F_ACC_RDONLY;
+  PropertyListHandle accessList(H5Fget_access_plist(file.get()));
+  mappable = mappable && accessList.isValid() && H5Pget_driver(accessList.get()) == H5FD_SEC2;
+  // Dataset addresses are relative to the end of the user block
+  PropertyListHandle createList(H5Fget_create_plist(file.get()));
+  hsize_t userBlockSize = 0;
+  if(createList.isValid())
+  {
+    H5Pget_userblock(createList.get(), &userBlockSize);
+  }
+  std::string fileName;
+  ssize_t nameLength = H5Fget_name(file.get(), nullptr, 0);
+  if(nameLength > 0)
+  {
+    fileName.resize(static_cast<size_t>(nameLength) + 1);
+    H5Fget_name(file.get(), &fileName.front(), fileName.size());
+    fileName.resize(static_cast<size_t>(nameLength));
+  }
+  file.close();
+  offset += userBlockSize;
+  if(!mappable || fileName.empty() || offset % alignof(T) != 0)
+  {
+    return false;
+  }
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd < 0)
+  {
+    return false;
+  }
+  const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t pageOffset = static_cast<size_t>(offset) % pageSize;
+  const size_t mappingSize = numElements * sizeof(T) + pageOffset;
+  void* mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(offset - pageOffset));
+  close(fd);
+  if(mapping == MAP_FAILED)
+  {
+    return false;
+  }
+  view.setMapping(mapping, mappingSize, reinterpret_cast<const T*>(static_cast<const uint8_t*>(mapping) + pageOffset), dims);
+  return true;
+#else
+  return false;
+#endif
+}
+} // namespace detail
+
+/**
+ * @brief Gives read-only access to a whole dataset without copying it when possible. Contiguous, unfiltered
+ * datasets of a file opened read-only with the default (sec2) driver are memory mapped so random access
+ * only loads the pages that are touched. Every other dataset, or a dataset whose stored type differs from T,
+ * is read into memory with H5Dread and the view owns that copy.
+ * @param locationID The parent location that contains the dataset to read
+ * @param datasetName The name of the dataset to read
+ * @param view Receives the data
+ * @return Standard HDF error condition
+ */
+template <typename T>
+inline herr_t mapDataset(hid_t locationID, const std::string& datasetName, MappedDataset<T>& view)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  herr_t error = 0;
+  herr_t returnError = 0;
+  view.reset();
+  hid_t dataType = HDFTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return -1;
+  }
+  DatasetHandle dataset(H5ObjectCache::openDataset(locationID, datasetName));
+  if(!dataset.isValid())
+  {
+    std::cout << "H5Lite.h::mapDataset(" << __LINE__ << ") Error opening Dataset at locationID (" << locationID << ") with object name (" << datasetName << ")" << std::endl;
+    return -1;
+  }
+  DataspaceHandle dataspace(H5Dget_space(dataset.get()));
+  if(!dataspace.isValid())
+  {
+    std::cout << "Error Opening SpaceID" << std::endl;
+    return static_cast<herr_t>(dataspace.get());
+  }
+  int32_t rank = H5Sget_simple_extent_ndims(dataspace.get());
+  std::vector<hsize_t> dims(std::max(rank, 0), 0);
+  if(rank > 0)
+  {
+    H5Sget_simple_extent_dims(dataspace.get(), dims.data(), nullptr);
+  }
+  if(!detail::mapContiguousDataset(dataset.get(), dims, view))
+  {
+    std::vector<T> copy(std::accumulate(dims.cbegin(), dims.cend(), static_cast<size_t>(1), std::multiplies<size_t>()));
+    if(!copy.empty())
+    {
+      error = H5Dread(dataset.get(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, copy.data());
+    }
+    if(error < 0)
+    {
+      std::cout << "Error Reading Data.'" << datasetName << "'" << std::endl;
+      returnError = error;
+    }
+    else
+    {
+      view.setCopy(std::move(copy), dims);
+    }
+  }
+  error = dataset.close();
+  if(error < 0)
+  {
+    std::cout << "Error Closing Dataset" << std::endl;
+    returnError = error;
+  }
+  return returnError;
+}
+} // namespace H5Lite
+} // namespace H5Support
@@ -0,0 +1,480 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <hdf5.h>
+
+#include "H5Support/H5Support.h"
+
+/**
+ * @brief An optional, per file cache of open dataset and group ids. Once a cache is enabled for a file the
+ * H5Lite read and attribute functions look their objects up in the cache instead of re-resolving the path and
+ * reloading the object header on every call. The cache is a bounded LRU list keyed by the absolute path
+ * of the object.
+ *
+ * The cache holds its own reference on every cached id, so the ids handed out are always closed by the caller
+ * as usual. Because those references keep the file open, disable the cache (or use H5Utilities::closeFile, which
+ * does it for you) before closing the file. Objects that are unlinked or moved outside of H5Support need to be
+ * removed with invalidate().
+ *
+ * The functions that call into HDF5 take the library lock (H5SUPPORT_MUTEX_LOCK) before the lock of the
+ * cache registry, in the same order as the H5Lite functions that use the cache.
+ */
+namespace H5Support
+{
+namespace H5ObjectCache
+{
+
+/**
+ * @brief Counters describing how effective a file's cache has been
+ */
+struct Statistics
+{
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;
+  size_t invalidations = 0;
+  size_t size = 0;
+  size_t capacity = 0;
+};
+
+/**
+ * @brief Bounded LRU map of absolute object path to an open HDF5 object id.
+ */
+class LRUCache
+{
+public:
+  explicit LRUCache(size_t capacity)
+  : m_Capacity(std::max<size_t>(capacity, 1))
+  {
+  }
+
+  ~LRUCache()
+  {
+    clear();
+  }
+
+  LRUCache(const LRUCache&) = delete;            // Copy Constructor Not Implemented
+  LRUCache(LRUCache&&) = delete;                 // Move Constructor Not Implemented
+  LRUCache& operator=(const LRUCache&) = delete; // Copy Assignment Not Implemented
+  LRUCache& operator=(LRUCache&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief Looks up a path. On a hit the id gets an extra reference that belongs to the caller.
+   * @param path The absolute path of the object
+   * @param objectType Receives the type of the cached object
+   * @return The object id or -1 if the path is not cached
+   */
+  hid_t find(const std::string& path, H5O_type_t& objectType)
+  {
+    auto iter = m_Index.find(path);
+    if(iter == m_Index.end())
+    {
+      m_Statistics.misses++;
+      return -1;
+    }
+    m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+    if(H5Iinc_ref(iter->second->objectID) < 0)
+    {
+      m_Statistics.misses++;
+      return -1;
+    }
+    m_Statistics.hits++;
+    objectType = iter->second->objectType;
+    return iter->second->objectID;
+  }
+
+  /**
+   * @brief Adds an object to the cache. The cache takes its own reference on the id.
+   * @param path The absolute path of the object
+   * @param objectID The open object id
+   * @param objectType The type of the object
+   */
+  void insert(const std::string& path, hid_t objectID, H5O_type_t objectType)
+  {
+    if(m_Index.find(path) != m_Index.end() || H5Iinc_ref(objectID) < 0)
+    {
+      return;
+    }
+    m_Entries.push_front({path, objectID, objectType});
+    m_Index[path] = m_Entries.begin();
+    while(m_Entries.size() > m_Capacity)
+    {
+      H5Oclose(m_Entries.back().objectID);
+      m_Index.erase(m_Entries.back().path);
+      m_Entries.pop_back();
+      m_Statistics.evictions++;
+    }
+  }
+
+  /**
+   * @brief Removes the object at path and every object below it
+   * @param path The absolute path of the object
+   */
+  void erase(const std::string& path)
+  {
+    const std::string prefix = path + "/";
+    for(auto iter = m_Entries.begin(); iter != m_Entries.end();)
+    {
+      if(iter->path == path || iter->path.compare(0, prefix.size(), prefix) == 0)
+      {
+        H5Oclose(iter->objectID);
+        m_Index.erase(iter->path);
+        iter = m_Entries.erase(iter);
+        m_Statistics.invalidations++;
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+  /**
+   * @brief Closes every cached id
+   */
+  void clear()
+  {
+    for(const auto& entry : m_Entries)
+    {
+      H5Oclose(entry.objectID);
+    }
+    m_Entries.clear();
+    m_Index.clear();
+  }
+
+  Statistics getStatistics() const
+  {
+    Statistics stats = m_Statistics;
+    stats.size = m_Entries.size();
+    stats.capacity = m_Capacity;
+    return stats;
+  }
+
+private:
+  struct Entry
+  {
+    std::string path;
+    hid_t objectID;
+    H5O_type_t objectType;
+  };
+
+  size_t m_Capacity = 1;
+  std::list<Entry> m_Entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_Index;
+  Statistics m_Statistics;
+};
+
+namespace detail
+{
+/**
+ * @brief Holds the caches of every file that has caching enabled, keyed by file id
+ */
+struct Registry
+{
+  std::mutex mutex;
+  std::map<hid_t, std::unique_ptr<LRUCache>> caches;
+};
+
+inline Registry& getRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+/**
+ * @brief Resolves the file that holds locationID and the absolute path of objectName.
+ * @param locationID The parent location
+ * @param objectName The name or path of the object relative to locationID
+ * @param path Receives the absolute path
+ * @return The file id (the caller must not close it) or -1 if the location can not be resolved
+ */
+inline hid_t resolve(hid_t locationID, const char* objectName, std::string& path)
+{
+  hid_t fileID = H5Iget_file_id(locationID);
+  if(fileID < 0)
+  {
+    return -1;
+  }
+  // H5Iget_file_id hands out a new reference on the existing file id
+  H5Idec_ref(fileID);
+
+  if(objectName[0] == '/')
+  {
+    path = objectName;
+    return fileID;
+  }
+  ssize_t length = H5Iget_name(locationID, nullptr, 0);
+  if(length <= 0)
+  {
+    return -1;
+  }
+  path.resize(static_cast<size_t>(length) + 1);
+  H5Iget_name(locationID, &path.front(), path.size());
+  path.resize(static_cast<size_t>(length));
+  if(path.back() != '/')
+  {
+    path.push_back('/');
+  }
+  path.append(objectName);
+  return fileID;
+}
+} // namespace detail
+
+/**
+ * @brief Enables the object cache for a file. Enabling it again changes nothing.
+ * @param fileID The file id
+ * @param capacity The maximum number of open ids the cache holds
+ * @return Standard HDF5 error condition
+ */
+inline herr_t enable(hid_t fileID, size_t capacity = 256)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(H5Iget_type(fileID) != H5I_FILE)
+  {
+    return -1;
+  }
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if(registry.caches.find(fileID) == registry.caches.end())
+  {
+    registry.caches[fileID] = std::make_unique<LRUCache>(capacity);
+  }
+  return 0;
+}
+
+/**
+ * @brief Closes every cached id of a file and disables its cache
+ * @param fileID The file id
+ * @return Standard HDF5 error condition
+ */
+inline herr_t disable(hid_t fileID)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.caches.erase(fileID);
+  return 0;
+}
+
+/**
+ * @brief Returns true if a cache is enabled for the given file
+ * @param fileID The file id
+ */
+inline bool isEnabled(hid_t fileID)
+{
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.caches.find(fileID) != registry.caches.end();
+}
+
+/**
+ * @brief Removes an object, and everything below it, from the cache of its file. Call this
+ * before unlinking, moving or replacing an object outside of H5Support.
+ * @param locationID The parent location
+ * @param objectName The name or path of the object relative to locationID
+ * @return Standard HDF5 error condition
+ */
+inline herr_t invalidate(hid_t locationID, const std::string& objectName)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if(registry.caches.empty())
+  {
+    return 0;
+  }
+  std::string path;
+  auto iter = registry.caches.find(detail::resolve(locationID, objectName.c_str(), path));
+  if(iter != registry.caches.end())
+  {
+    iter->second->erase(path);
+  }
+  return 0;
+}
+
+/**
+ * @brief Returns the hit/miss counters of a file's cache
+ * @param fileID The file id
+ * @param stats Receives the counters
+ * @return Negative if no cache is enabled for the file
+ */
+inline herr_t getStatistics(hid_t fileID, Statistics& stats)
+{
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto iter = registry.caches.find(fileID);
+  if(iter == registry.caches.end())
+  {
+    return -1;
+  }
+  stats = iter->second->getStatistics();
+  return 0;
+}
+
+/**
+ * @brief Opens a dataset or group, going through the cache of its file when one is enabled.
+ * The returned id must be closed by the caller.
+ * @param locationID The parent location
+ * @param objectName The name or path of the object relative to locationID
+ * @param objectType Receives the type of the object
+ * @return The object id or a negative value on error
+ */
+inline hid_t openObject(hid_t locationID, const char* objectName, H5O_type_t& objectType)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  detail::Registry& registry = detail::getRegistry();
+  std::unique_lock<std::mutex> lock(registry.mutex);
+  LRUCache* cache = nullptr;
+  std::string path;
+  if(!registry.caches.empty())
+  {
+    auto iter = registry.caches.find(detail::resolve(locationID, objectName, path));
+    if(iter != registry.caches.end())
+    {
+      cache = iter->second.get();
+      hid_t objectID = cache->find(path, objectType);
+      if(objectID >= 0)
+      {
+        return objectID;
+      }
+    }
+  }
+
+  H5O_info_t objectInfo{};
+  herr_t error = H5Oget_info_by_name(locationID, objectName, &objectInfo, H5P_DEFAULT);
+  if(error < 0)
+  {
+    return error;
+  }
+  objectType = objectInfo.type;
+  hid_t objectID = -1;
+  switch(objectType)
+  {
+  case H5O_TYPE_DATASET:
+    objectID = H5Dopen(locationID, objectName, H5P_DEFAULT);
+    break;
+  case H5O_TYPE_GROUP:
+    objectID = H5Gopen(locationID, objectName, H5P_DEFAULT);
+    break;
+  default:
+    return -1;
+  }
+  if(objectID >= 0 && cache != nullptr)
+  {
+    cache->insert(path, objectID, objectType);
+  }
+  return objectID;
+}
+
+/**
+ * @brief Opens a dataset or group, going through the cache of its file when one is enabled.
+ * The returned id must be closed by the caller.
+ */
+inline hid_t openObject(hid_t locationID, const std::string& objectName, H5O_type_t& objectType)
+{
+  return openObject(locationID, objectName.c_str(), objectType);
+}
+
+/**
+ * @brief Opens a dataset, going through the cache of its file when one is enabled.
+ * The returned id must be closed with H5Dclose.
+ * @param locationID The parent location
+ * @param datasetName The name or path of the dataset relative to locationID
+ * @return The dataset id or a negative value on error
+ */
+inline hid_t openDataset(hid_t locationID, const char* datasetName)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  detail::Registry& registry = detail::getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  LRUCache* cache = nullptr;
+  std::string path;
+  if(!registry.caches.empty())
+  {
+    auto iter = registry.caches.find(detail::resolve(locationID, datasetName, path));
+    if(iter != registry.caches.end())
+    {
+      cache = iter->second.get();
+      H5O_type_t objectType = H5O_TYPE_UNKNOWN;
+      hid_t objectID = cache->find(path, objectType);
+      if(objectID >= 0 && objectType == H5O_TYPE_DATASET)
+      {
+        return objectID;
+      }
+      if(objectID >= 0)
+      {
+        H5Oclose(objectID);
+        return -1;
+      }
+    }
+  }
+
+  hid_t datasetID = H5Dopen(locationID, datasetName, H5P_DEFAULT);
+  if(datasetID >= 0 && cache != nullptr)
+  {
+    cache->insert(path, datasetID, H5O_TYPE_DATASET);
+  }
+  return datasetID;
+}
+
+/**
+ * @brief Opens a dataset, going through the cache of its file when one is enabled.
+ * The returned id must be closed with H5Dclose.
+ */
+inline hid_t openDataset(hid_t locationID, const std::string& datasetName)
+{
+  return openDataset(locationID, datasetName.c_str());
+}
+
+} // namespace H5ObjectCache
+} // namespace H5Support
@@ -0,0 +1,198 @@
+/* ============================================================================
+ * Copyright (c) 2009-2019 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace H5Support
+{
+
+/**
+ * @brief Holds an HDF5 object path together with its null terminated form so it can be handed to HDF5 over
+ * and over without being copied. An H5Path converts to const std::string&, so it can be passed to every
+ * H5Lite and H5Utilities function that takes a name and no temporary string gets built for the call.
+ * Paths that change inside a loop should be rebuilt with assign() and append(), which reuse the storage.
+ */
+class H5Path
+{
+public:
+  H5Path() = default;
+
+  H5Path(const char* path)
+  : m_Path(path)
+  {
+  }
+
+  H5Path(std::string path)
+  : m_Path(std::move(path))
+  {
+  }
+
+  H5Path(std::string_view path)
+  : m_Path(path)
+  {
+  }
+
+  /**
+   * @brief Returns the null terminated path that HDF5 functions expect
+   */
+  const char* c_str() const
+  {
+    return m_Path.c_str();
+  }
+
+  const std::string& str() const
+  {
+    return m_Path;
+  }
+
+  std::string_view view() const
+  {
+    return m_Path;
+  }
+
+  operator const std::string&() const
+  {
+    return m_Path;
+  }
+
+  bool empty() const
+  {
+    return m_Path.empty();
+  }
+
+  size_t size() const
+  {
+    return m_Path.size();
+  }
+
+  /**
+   * @brief Replaces the path, reusing the storage that is already allocated
+   */
+  H5Path& assign(std::string_view path)
+  {
+    m_Path.assign(path.data(), path.size());
+    return *this;
+  }
+
+  /**
+   * @brief Appends a child name, adding the '/' separator if needed
+   */
+  H5Path& append(std::string_view name)
+  {
+    if(!m_Path.empty() && m_Path.back() != '/' && (name.empty() || name.front() != '/'))
+    {
+      m_Path.push_back('/');
+    }
+    m_Path.append(name.data(), name.size());
+    return *this;
+  }
+
+  /**
+   * @brief Sets the length of the path. Used together with data() to let HDF5 write a name directly into the path.
+   */
+  void resize(size_t size)
+  {
+    m_Path.resize(size);
+  }
+
+  char* data()
+  {
+    return &m_Path[0];
+  }
+
+  /**
+   * @brief Returns the last component of the path. The view points into this path.
+   */
+  std::string_view getObjectName() const
+  {
+    return objectName(m_Path);
+  }
+
+  /**
+   * @brief Returns everything before the last component of the path. The view points into this path.
+   */
+  std::string_view getParentPath() const
+  {
+    return parentPath(m_Path);
+  }
+
+  /**
+   * @brief Returns the last component of a path without copying it. "/" is returned as is.
+   */
+  static std::string_view objectName(std::string_view path)
+  {
+    std::string_view::size_type pos = path.find_last_of('/');
+    if(pos == std::string_view::npos || path == "/")
+    {
+      return path;
+    }
+    return path.substr(pos + 1);
+  }
+
+  /**
+   * @brief Returns everything before the last '/' of a path without copying it. A name without
+   * any '/' has an empty parent path.
+   */
+  static std::string_view parentPath(std::string_view path)
+  {
+    std::string_view::size_type pos = path.find_last_of('/');
+    if(pos == std::string_view::npos)
+    {
+      return {};
+    }
+    return path.substr(0, pos);
+  }
+
+  bool operator==(const H5Path& other) const
+  {
+    return m_Path == other.m_Path;
+  }
+
+  bool operator!=(const H5Path& other) const
+  {
+    return m_Path != other.m_Path;
+  }
+
+private:
+  std::string m_Path;
+};
+
+} // namespace H5Support
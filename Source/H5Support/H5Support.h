@@ -1,10 +1,107 @@
 #pragma once
 
 #ifdef H5Support_USE_MUTEX
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <mutex>
-#define H5SUPPORT_MUTEX_LOCK()                                                                                                                                                                         \
-  std::mutex mutex;                                                                                                                                                                                    \
-  std::lock_guard<std::mutex> lock(mutex);
+
+namespace H5Support
+{
+/**
+ * @brief Counters describing how often callers had to wait for the library lock and for how long
+ */
+struct LockStatistics
+{
+  uint64_t acquisitions = 0;
+  uint64_t contentions = 0;
+  uint64_t waitNanoseconds = 0;
+};
+
+namespace detail
+{
+/**
+ * @brief The process wide, recursive lock taken by every H5Support function. It serializes all calls into a
+ * libhdf5 that was not built thread safe and counts how much time callers spend waiting for it.
+ */
+class LibraryMutex
+{
+public:
+  LibraryMutex() = default;
+  ~LibraryMutex() = default;
+
+  LibraryMutex(const LibraryMutex&) = delete;            // Copy Constructor Not Implemented
+  LibraryMutex(LibraryMutex&&) = delete;                 // Move Constructor Not Implemented
+  LibraryMutex& operator=(const LibraryMutex&) = delete; // Copy Assignment Not Implemented
+  LibraryMutex& operator=(LibraryMutex&&) = delete;      // Move Assignment Not Implemented
+
+  void lock()
+  {
+    m_Acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if(m_Mutex.try_lock())
+    {
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    m_Mutex.lock();
+    auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    m_Contentions.fetch_add(1, std::memory_order_relaxed);
+    m_WaitNanoseconds.fetch_add(static_cast<uint64_t>(waited.count()), std::memory_order_relaxed);
+  }
+
+  void unlock()
+  {
+    m_Mutex.unlock();
+  }
+
+  LockStatistics getStatistics() const
+  {
+    LockStatistics stats;
+    stats.acquisitions = m_Acquisitions.load(std::memory_order_relaxed);
+    stats.contentions = m_Contentions.load(std::memory_order_relaxed);
+    stats.waitNanoseconds = m_WaitNanoseconds.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  void resetStatistics()
+  {
+    m_Acquisitions = 0;
+    m_Contentions = 0;
+    m_WaitNanoseconds = 0;
+  }
+
+private:
+  std::recursive_mutex m_Mutex;
+  std::atomic<uint64_t> m_Acquisitions = {0};
+  std::atomic<uint64_t> m_Contentions = {0};
+  std::atomic<uint64_t> m_WaitNanoseconds = {0};
+};
+
+inline LibraryMutex& getLibraryMutex()
+{
+  static LibraryMutex mutex;
+  return mutex;
+}
+} // namespace detail
+
+/**
+ * @brief Returns the contention counters of the library lock
+ */
+inline LockStatistics getLockStatistics()
+{
+  return detail::getLibraryMutex().getStatistics();
+}
+
+/**
+ * @brief Sets the contention counters of the library lock back to zero
+ */
+inline void resetLockStatistics()
+{
+  detail::getLibraryMutex().resetStatistics();
+}
+} // namespace H5Support
+
+#define H5SUPPORT_MUTEX_LOCK() std::lock_guard<H5Support::detail::LibraryMutex> h5SupportLibraryLock(H5Support::detail::getLibraryMutex());
 #else
 #define H5SUPPORT_MUTEX_LOCK()
 #endif
@@ -34,45 +34,30 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <string>
+#include <vector>
 
 #include <hdf5.h>
 #include "H5Fpublic.h"
 
+#include "H5Support/H5FileAccessOptions.h"
+#include "H5Support/H5FileCreateOptions.h"
+#include "H5Support/H5GroupCreateOptions.h"
+#include "H5Support/H5GroupPathCache.h"
 #include "H5Support/H5Lite.h"
+#include "H5Support/H5ObjectCache.h"
+#include "H5Support/H5Path.h"
 #include "H5Support/H5Support.h"
 
-/**
- * Define the libraries features and file compatibility that will be used when opening
- * or creating a file
- */
-#if(H5_VERS_MINOR == 8)
-#define HDF5_VERSION_LIB_LOWER_BOUNDS H5F_LIBVER_18
-#define HDF5_VERSION_LIB_UPPER_BOUNDS H5F_LIBVER_LATEST
-#endif
-
-#if(H5_VERS_MINOR == 10)
-#define HDF5_VERSION_LIB_LOWER_BOUNDS H5F_LIBVER_V110
-#define HDF5_VERSION_LIB_UPPER_BOUNDS H5F_LIBVER_LATEST
-#endif
-
-#if(H5_VERS_MINOR == 12)
-#define HDF5_VERSION_LIB_LOWER_BOUNDS H5F_LIBVER_V112
-#define HDF5_VERSION_LIB_UPPER_BOUNDS H5F_LIBVER_LATEST
-#endif
-
-#if(H5_VERS_MINOR == 14)
-#define HDF5_VERSION_LIB_LOWER_BOUNDS H5F_LIBVER_V114
-#define HDF5_VERSION_LIB_UPPER_BOUNDS H5F_LIBVER_LATEST
-#endif
-
-#ifndef HDF5_VERSION_LIB_LOWER_BOUNDS
-#error HDF5_VERSION_LIB_LOWER_BOUNDS is not defined. Please check the version of HDF5 that you are compiling against
-#endif
-
 namespace H5Support {
 
 #define ENABLE_BITMASK_OPERATORS(x)                                                                                                                                                                    \
@@ -112,36 +97,79 @@ enum class CustomHDFDataTypes : int32_t
 
 // -----------HDF5 File Operations
 /**
- * @brief Opens a H5 file at path filename. Can be made read only access. Returns the id of the file object.
+ * @brief Opens a H5 file at path filename with the given file access options. Can be made read only access.
+ * Returns the id of the file object.
  * @param filename
  * @param readOnly
+ * @param options The driver, cache and alignment settings to open the file with
  * @return
  */
-inline hid_t openFile(const std::string& filename, bool readOnly = false)
+inline hid_t openFile(const std::string& filename, bool readOnly, const FileAccessOptions& options)
 {
   H5SUPPORT_MUTEX_LOCK()
 
   HDF_ERROR_HANDLER_OFF
   hid_t fileID = -1;
-  if(readOnly)
+  /* Create a file access property list */
+  PropertyListHandle fileAccessPropertyList(options.createPropertyList());
+  if(fileAccessPropertyList.isValid())
   {
-    fileID = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    fileID = H5Fopen(filename.c_str(), readOnly ? H5F_ACC_RDONLY : H5F_ACC_RDWR, fileAccessPropertyList.get());
   }
-  else
-  {
-    /* Create a file access property list */
-    hid_t fileAccessPropertyList = H5Pcreate(H5P_FILE_ACCESS);
 
-    /* Set the file access property list */
-    H5Pset_libver_bounds(fileAccessPropertyList, HDF5_VERSION_LIB_LOWER_BOUNDS, HDF5_VERSION_LIB_UPPER_BOUNDS);
-    fileID = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+  HDF_ERROR_HANDLER_ON
+  return fileID;
+}
+
+/**
+ * @brief Opens a H5 file at path filename. Can be made read only access. Returns the id of the file object.
+ * @param filename
+ * @param readOnly
+ * @return
+ */
+inline hid_t openFile(const std::string& filename, bool readOnly = false)
+{
+  return openFile(filename, readOnly, FileAccessOptions());
+}
+
+/**
+ * @brief Creates a H5 file at path filename with the given file access and creation options. Returns the id
+ * of the file object.
+ * @param filename
+ * @param options The driver, cache and alignment settings to create the file with
+ * @param createOptions The file space strategy and user block to create the file with
+ * @return
+ */
+inline hid_t createFile(const std::string& filename, const FileAccessOptions& options, const FileCreateOptions& createOptions)
+{
+  H5SUPPORT_MUTEX_LOCK()
 
-    /* Close the file access property list object */
-    H5Pclose(fileAccessPropertyList);
+  /* Create a file access property list */
+  PropertyListHandle fileAccessPropertyList(options.createPropertyList());
+  if(!fileAccessPropertyList.isValid())
+  {
+    return fileAccessPropertyList.get();
+  }
+  /* Create a file creation property list */
+  PropertyListHandle fileCreatePropertyList(createOptions.createPropertyList());
+  if(!fileCreatePropertyList.isValid())
+  {
+    return fileCreatePropertyList.get();
   }
 
-  HDF_ERROR_HANDLER_ON
-  return fileID;
+  /* Create a file with these property lists */
+  return H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, fileCreatePropertyList.get(), fileAccessPropertyList.get());
+}
+
+/**
+ * @brief Creates a H5 file at path filename with the given file access options. Returns the id of the file object.
+ * @param filename
+ * @param options The driver, cache and alignment settings to create the file with
+ * @return
+ */
+inline hid_t createFile(const std::string& filename, const FileAccessOptions& options)
+{
+  return createFile(filename, options, FileCreateOptions());
 }
 
 /**
@@ -150,24 +178,229 @@ inline hid_t openFile(const std::string& filename, bool readOnly = false)
  * @return
  */
 inline hid_t createFile(const std::string& filename)
+{
+  return createFile(filename, FileAccessOptions());
+}
+
+namespace detail
+{
+/**
+ * @brief Returns a name for an in-memory file that no other open in-memory file uses. The core driver
+ * tells files without a backing store apart by name only.
+ */
+inline std::string getUniqueImageName()
+{
+  static std::atomic<uint64_t> counter(0);
+  return "H5Support_InMemoryFile_" + std::to_string(++counter);
+}
+
+/**
+ * @brief Bob Jenkins' lookup3 hash (hashlittle), which HDF5 uses as the checksum of its version 2 and
+ * later metadata.
+ */
+inline uint32_t checksumLookup3(const uint8_t* key, size_t length, uint32_t initval = 0)
+{
+  auto rot = [](uint32_t x, uint32_t k) { return (x << k) | (x >> (32 - k)); };
+  auto word = [](const uint8_t* bytes) {
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+  };
+  uint32_t a = 0xdeadbeef + static_cast<uint32_t>(length) + initval;
+  uint32_t b = a;
+  uint32_t c = a;
+  while(length > 12)
+  {
+    a += word(key);
+    b += word(key + 4);
+    c += word(key + 8);
+    a -= c;
+    a ^= rot(c, 4);
+    c += b;
+    b -= a;
+    b ^= rot(a, 6);
+    a += c;
+    c -= b;
+    c ^= rot(b, 8);
+    b += a;
+    a -= c;
+    a ^= rot(c, 16);
+    c += b;
+    b -= a;
+    b ^= rot(a, 19);
+    a += c;
+    c -= b;
+    c ^= rot(b, 4);
+    b += a;
+    length -= 12;
+    key += 12;
+  }
+  if(length == 0)
+  {
+    return c;
+  }
+  std::array<uint8_t, 12> tail = {0};
+  std::copy(key, key + length, tail.begin());
+  a += word(tail.data());
+  b += word(tail.data() + 4);
+  c += word(tail.data() + 8);
+  c ^= b;
+  c -= rot(b, 14);
+  a ^= c;
+  a -= rot(c, 11);
+  b ^= a;
+  b -= rot(a, 25);
+  c ^= b;
+  c -= rot(b, 16);
+  a ^= c;
+  a -= rot(c, 4);
+  b ^= a;
+  b -= rot(a, 14);
+  c ^= b;
+  c -= rot(b, 24);
+  return c;
+}
+
+/**
+ * @brief H5Fget_file_image clears the file consistency flags of a version 2 or 3 superblock in the image of
+ * a file that is open for writing but (up to at least HDF5 1.10.8) leaves the old checksum in place, so
+ * the image cannot be opened again. Recomputes the superblock checksum of the image.
+ */
+inline void fixSuperblockChecksum(std::vector<uint8_t>& image)
+{
+  const std::array<uint8_t, 8> signature = {0x89, 'H', 'D', 'F', '\r', '\n', 0x1a, '\n'};
+  // The superblock is at the start of the file or after a user block of 512 bytes times a power of two
+  for(size_t offset = 0; offset + 12 <= image.size(); offset = (offset == 0 ? 512 : offset * 2))
+  {
+    if(!std::equal(signature.begin(), signature.end(), image.begin() + offset))
+    {
+      continue;
+    }
+    const uint8_t version = image[offset + 8];
+    const size_t checksumOffset = offset + 12 + 4 * static_cast<size_t>(image[offset + 9]);
+    if(version >= 2 && checksumOffset + 4 <= image.size())
+    {
+      const uint32_t checksum = checksumLookup3(image.data() + offset, checksumOffset - offset);
+      for(size_t i = 0; i < 4; i++)
+      {
+        image[checksumOffset + i] = static_cast<uint8_t>(checksum >> (8 * i));
+      }
+    }
+    return;
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Creates an HDF5 file that lives entirely in memory using the core driver. Nothing is written to
+ * disk; use getFileImage to retrieve the bytes of the file before closing it.
+ * @param incrementSize The number of bytes the memory image grows by when it fills up
+ * @param options Further file access options. The driver is replaced by the core driver.
+ * @return The id of the file object or a negative value on error
+ */
+inline hid_t createInMemoryFile(size_t incrementSize, const FileAccessOptions& options)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  /* Create a file access property list */
-  hid_t fileAccessPropertyList = H5Pcreate(H5P_FILE_ACCESS);
+  FileAccessOptions coreOptions = options;
+  coreOptions.setCoreDriver(incrementSize, false);
+  PropertyListHandle fileAccessPropertyList(coreOptions.createPropertyList());
+  if(!fileAccessPropertyList.isValid())
+  {
+    return fileAccessPropertyList.get();
+  }
+  return H5Fcreate(detail::getUniqueImageName().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fileAccessPropertyList.get());
+}
 
-  /* Set the fapl */
-  H5Pset_libver_bounds(fileAccessPropertyList, HDF5_VERSION_LIB_LOWER_BOUNDS, HDF5_VERSION_LIB_UPPER_BOUNDS);
+/**
+ * @brief Creates an HDF5 file that lives entirely in memory using the core driver.
+ * @param incrementSize The number of bytes the memory image grows by when it fills up
+ * @return The id of the file object or a negative value on error
+ */
+inline hid_t createInMemoryFile(size_t incrementSize = 1024 * 1024)
+{
+  return createInMemoryFile(incrementSize, FileAccessOptions());
+}
 
-  /* Create a file with this file access property list */
-  hid_t fileID = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fileAccessPropertyList);
+/**
+ * @brief Copies the complete image of an open file into a byte buffer. The file is flushed first so the
+ * image can be written out or handed to openFileImage as is. Works for in-memory and on-disk files.
+ * @param fileID The open file
+ * @param image Receives the bytes of the file
+ * @return Standard HDF5 error condition
+ */
+inline herr_t getFileImage(hid_t fileID, std::vector<uint8_t>& image)
+{
+  H5SUPPORT_MUTEX_LOCK()
 
-  /* Close the file access property list object */
-  H5Pclose(fileAccessPropertyList);
+  herr_t error = H5Fflush(fileID, H5F_SCOPE_LOCAL);
+  if(error < 0)
+  {
+    std::cout << "Error flushing the file before getting its image" << std::endl;
+    return error;
+  }
+  ssize_t imageSize = H5Fget_file_image(fileID, nullptr, 0);
+  if(imageSize < 0)
+  {
+    std::cout << "Error getting the size of the file image" << std::endl;
+    return static_cast<herr_t>(imageSize);
+  }
+  image.resize(static_cast<size_t>(imageSize));
+  if(H5Fget_file_image(fileID, image.data(), image.size()) < 0)
+  {
+    std::cout << "Error getting the file image" << std::endl;
+    image.clear();
+    return -1;
+  }
+  uint32_t intent = 0;
+  if(H5Fget_intent(fileID, &intent) >= 0 && (intent & H5F_ACC_RDWR) != 0)
+  {
+    detail::fixSuperblockChecksum(image);
+  }
+  return 0;
+}
 
+/**
+ * @brief Opens a file image held in memory, for example one produced by getFileImage or received over the
+ * network. The image is copied by HDF5 so the buffer may be released once this returns. Changes made to a
+ * writable image stay in memory and can be retrieved with getFileImage.
+ * @param buffer The bytes of the file
+ * @param size The number of bytes in the buffer
+ * @param readOnly Open the image read only
+ * @return The id of the file object or a negative value on error
+ */
+inline hid_t openFileImage(const void* buffer, size_t size, bool readOnly = true)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  FileAccessOptions options;
+  options.setCoreDriver(std::max(size, static_cast<size_t>(64 * 1024)), false);
+  PropertyListHandle fileAccessPropertyList(options.createPropertyList());
+  if(!fileAccessPropertyList.isValid())
+  {
+    return fileAccessPropertyList.get();
+  }
+  herr_t error = H5Pset_file_image(fileAccessPropertyList.get(), const_cast<void*>(buffer), size);
+  if(error < 0)
+  {
+    std::cout << "Error setting the file image" << std::endl;
+    return error;
+  }
+  HDF_ERROR_HANDLER_OFF
+  hid_t fileID = H5Fopen(detail::getUniqueImageName().c_str(), readOnly ? H5F_ACC_RDONLY : H5F_ACC_RDWR, fileAccessPropertyList.get());
+  HDF_ERROR_HANDLER_ON
   return fileID;
 }
 
+/**
+ * @brief Opens a file image held in memory.
+ * @param image The bytes of the file
+ * @param readOnly Open the image read only
+ * @return The id of the file object or a negative value on error
+ */
+inline hid_t openFileImage(const std::vector<uint8_t>& image, bool readOnly = true)
+{
+  return openFileImage(image.data(), image.size(), readOnly);
+}
+
 /**
  * @brief Closes the object id
  * @param locId The object id to close
@@ -227,7 +460,9 @@ inline herr_t closeHDF5Object(hid_t objectID)
 }
 
 /**
- * @brief Closes a H5 file object. Returns the H5 error code.
+ * @brief Closes a H5 file object. Returns the H5 error code. Ids of objects in the file that are still
+ * open are not closed; HDF5 keeps the file open until the last of them is closed. Hold ids in the
+ * handle types of H5Handles.h so they are closed when they go out of scope.
  * @param fileID
  * @return
  */
@@ -235,36 +470,16 @@ inline herr_t closeFile(hid_t& fileID)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  herr_t err = 1;
   if(fileID < 0) // fileID isn't open
   {
     return 1;
   }
 
-  // Get the number of open identifiers of all types
-  //  except files
-  ssize_t numOpen = H5Fget_obj_count(fileID, H5F_OBJ_DATASET | H5F_OBJ_GROUP | H5F_OBJ_DATATYPE | H5F_OBJ_ATTR | H5F_OBJ_LOCAL);
-  if(numOpen > 0)
-  {
-    std::cout << "WARNING: Some IDs weren't closed. Closing them." << std::endl;
-    std::vector<hid_t> attributeIDs(numOpen, 0);
-    H5Fget_obj_ids(fileID, H5F_OBJ_DATASET | H5F_OBJ_GROUP | H5F_OBJ_DATATYPE | H5F_OBJ_ATTR, numOpen, attributeIDs.data());
-    std::array<char, 1024> name;
-    for(const auto& id : attributeIDs)
-    {
-      name.fill(0);
-      ssize_t charsRead = H5Iget_name(id, name.data(), name.size());
-      if(charsRead < 0)
-      {
-        std::cout << "Error Trying to get the name of an hdf object that was not closed. This is probably pretty bad. " << __FILE__ << "(" << __LINE__ << ")" << std::endl;
-        return -1;
-      }
-      std::cout << "H5 Object left open. Id=" << id << " Name='" << name.data() << "'" << std::endl;
-      H5Utilities::closeHDF5Object(id);
-    }
-  }
+  // Release the ids held by the caches
+  H5ObjectCache::disable(fileID);
+  H5GroupPathCache::disable(fileID);
 
-  err = H5Fclose(fileID);
+  herr_t err = H5Fclose(fileID);
   if(err < 0)
   {
     std::cout << "Error Closing HDF5 File. " << err << std::endl;
@@ -273,6 +488,76 @@ inline herr_t closeFile(hid_t& fileID)
   return err;
 }
 
+namespace detail
+{
+/**
+ * @brief H5Ovisit callback that does nothing. Visiting loads every object header into the metadata cache.
+ */
+inline herr_t touchObject(hid_t /*objectID*/, const char* /*name*/, const H5O_info_t* /*info*/, void* /*opData*/)
+{
+  return 0;
+}
+} // namespace detail
+
+/**
+ * @brief Loads the metadata of every object of a file into the metadata cache and closes the file with a
+ * metadata cache image. Later opens then load the metadata in one sequential read instead of walking the
+ * file. The image is consumed (and removed) by the next read/write open, so run this again after modifying
+ * the file; read only opens leave it in place.
+ * @param filename The file to write the cache image into
+ * @param options File access options to open the file with. The cache should be large enough to hold the
+ * metadata of the whole file, see FileAccessOptions::setMetadataCacheSize.
+ * @return Standard HDF5 error condition
+ */
+inline herr_t writeMetadataCacheImage(const std::string& filename, const FileAccessOptions& options = FileAccessOptions())
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  FileAccessOptions imageOptions = options;
+  imageOptions.setMetadataCacheImage();
+  hid_t fileID = openFile(filename, false, imageOptions);
+  if(fileID < 0)
+  {
+    std::cout << "Error opening file '" << filename << "' to write a metadata cache image" << std::endl;
+    return static_cast<herr_t>(fileID);
+  }
+  herr_t returnError = H5Ovisit(fileID, H5_INDEX_NAME, H5_ITER_NATIVE, detail::touchObject, nullptr);
+  if(returnError < 0)
+  {
+    std::cout << "Error visiting the objects of file '" << filename << "'" << std::endl;
+  }
+  herr_t error = closeFile(fileID);
+  if(error < 0)
+  {
+    returnError = error;
+  }
+  return returnError;
+}
+
+/**
+ * @brief Returns the size of the metadata cache image of a file, 0 if it has none. Call this right after
+ * opening the file, a read/write open deletes the image as soon as it is loaded.
+ * @param fileID The open file
+ * @return The size of the image in bytes, negative on error
+ */
+inline hssize_t getMetadataCacheImageSize(hid_t fileID)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+#if H5_VERSION_GE(1, 10, 1)
+  haddr_t imageAddress = HADDR_UNDEF;
+  hsize_t imageSize = 0;
+  herr_t error = H5Fget_mdc_image_info(fileID, &imageAddress, &imageSize);
+  if(error < 0)
+  {
+    return error;
+  }
+  return static_cast<hssize_t>(imageSize);
+#else
+  return 0;
+#endif
+}
+
 // -------------- HDF Indentifier Methods ----------------------------
 /**
  * @brief Returns the path to an object
@@ -297,6 +582,27 @@ inline std::string getObjectPath(hid_t locationID, bool trim = false)
   return objectPath;
 }
 
+/**
+ * @brief Writes the absolute path of an object into an existing H5Path, reusing its storage
+ * @param locationID The HDF5 id of the object
+ * @param objectPath Receives the path
+ * @return Negative value on error
+ */
+inline herr_t getObjectPath(hid_t locationID, H5Path& objectPath)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  ssize_t length = H5Iget_name(locationID, nullptr, 0);
+  if(length <= 0)
+  {
+    objectPath.resize(0);
+    return -1;
+  }
+  objectPath.resize(static_cast<size_t>(length));
+  H5Iget_name(locationID, objectPath.data(), static_cast<size_t>(length) + 1);
+  return 0;
+}
+
 /**
  * @brief Returns the hdf object type
  * @param objectID The hdf5 object id
@@ -327,15 +633,17 @@ inline herr_t getObjectType(hid_t objectID, const std::string& objectName, int32
  * @param fileID The hdf5 object id
  * @param index The index to retrieve the name for
  * @param name The variable to store the name
+ * @param indexType H5_INDEX_NAME or H5_INDEX_CRT_ORDER. Lookups by creation order are only fast in groups
+ * created with an indexed creation order, see GroupCreateOptions::setCreationOrder.
  * @return Negative value is error
  */
-inline herr_t objectNameAtIndex(hid_t fileID, int32_t index, std::string& name)
+inline herr_t objectNameAtIndex(hid_t fileID, int32_t index, std::string& name, H5_index_t indexType = H5_INDEX_NAME)
 {
   H5SUPPORT_MUTEX_LOCK()
 
   ssize_t error = -1;
   // call H5Gget_objname_by_idx with name as nullptr to get its length
-  ssize_t nameSize = H5Lget_name_by_idx(fileID, ".", H5_INDEX_NAME, H5_ITER_NATIVE, static_cast<hsize_t>(index), nullptr, 0, H5P_DEFAULT);
+  ssize_t nameSize = H5Lget_name_by_idx(fileID, ".", indexType, H5_ITER_NATIVE, static_cast<hsize_t>(index), nullptr, 0, H5P_DEFAULT);
   if(nameSize < 0)
   {
     name.clear();
@@ -343,7 +651,7 @@ inline herr_t objectNameAtIndex(hid_t fileID, int32_t index, std::string& name)
   }
 
   std::vector<char> buffer(nameSize + 1, 0);
-  error = H5Lget_name_by_idx(fileID, ".", H5_INDEX_NAME, H5_ITER_NATIVE, static_cast<hsize_t>(index), buffer.data(), buffer.size(), H5P_DEFAULT);
+  error = H5Lget_name_by_idx(fileID, ".", indexType, H5_ITER_NATIVE, static_cast<hsize_t>(index), buffer.data(), buffer.size(), H5P_DEFAULT);
   if(error < 0)
   {
     std::cout << "Error Trying to get the dataset name for index " << index << std::endl;
@@ -364,10 +672,7 @@ inline herr_t objectNameAtIndex(hid_t fileID, int32_t index, std::string& name)
  */
 inline std::string getParentPath(const std::string& objectPath)
 {
-  std::string parentPath = objectPath;
-  size_t start = parentPath.find_last_of('/');
-  parentPath.erase(start, parentPath.size() - start);
-  return parentPath;
+  return std::string(H5Path::parentPath(objectPath));
 }
 
 /**
@@ -577,69 +882,209 @@ inline void printHDFClassType(H5T_class_t classType)
 
 // -------------- HDF Group Methods ----------------------------
 /**
- * @brief Returns a list of child hdf5 objects for a given object id
- * @param locationID The parent hdf5 id
- * @param typeFilter A filter to apply to the list
- * @param names Variable to store the list
- * @return
+ * @brief The members of a group as filled in by listGroup. The names are stored back to back (each null
+ * terminated) in a single buffer, so listing a group costs a handful of allocations however many members it has.
  */
-inline herr_t getGroupObjects(hid_t locationID, CustomHDFDataTypes typeFilter, std::list<std::string>& names)
+class GroupListing
 {
-  H5SUPPORT_MUTEX_LOCK()
+public:
+  size_t size() const
+  {
+    return m_Offsets.size();
+  }
 
-  herr_t error = 0;
-  hsize_t numObjects = 0;
-  H5G_info_t groupInfo{};
-  error = H5Gget_info(locationID, &groupInfo);
-  if(error < 0)
+  bool empty() const
   {
-    // std::cout << "Error getting number of objects for group: " << locationID << std::endl;
-    return error;
+    return m_Offsets.empty();
   }
-  numObjects = groupInfo.nlinks;
 
-  if(numObjects <= 0)
+  void clear()
   {
-    return 0; // no objects in group
+    m_Names.clear();
+    m_Offsets.clear();
+    m_Types.clear();
+    m_CreationOrder.clear();
   }
 
-  size_t size = 0;
-  H5O_type_t type = H5O_TYPE_NTYPES;
+  void reserve(size_t count)
+  {
+    m_Offsets.reserve(count);
+    m_Types.reserve(count);
+    m_CreationOrder.reserve(count);
+  }
 
-  std::vector<char> name;
+  /**
+   * @brief Returns the null terminated name of a member. The pointer stays valid until the listing is changed.
+   */
+  const char* getName(size_t index) const
+  {
+    return m_Names.data() + m_Offsets[index];
+  }
 
-  for(hsize_t i = 0; i < numObjects; i++)
+  /**
+   * @brief Returns the type of the object a member links to, H5O_TYPE_UNKNOWN for dangling links or when
+   * the types were not resolved
+   */
+  H5O_type_t getType(size_t index) const
   {
-    size = 1 + H5Lget_name_by_idx(locationID, ".", H5_INDEX_NAME, H5_ITER_INC, i, nullptr, 0, H5P_DEFAULT);
+    return m_Types[index];
+  }
 
-    name.resize(size, 0);
+  /**
+   * @brief Returns the creation order of a member or -1 if the group does not track it
+   */
+  int64_t getCreationOrder(size_t index) const
+  {
+    return m_CreationOrder[index];
+  }
 
-    H5Lget_name_by_idx(locationID, ".", H5_INDEX_NAME, H5_ITER_INC, i, name.data(), size, H5P_DEFAULT);
-    if(typeFilter == CustomHDFDataTypes::Any)
-    {
-      std::string objectName(name.data());
-      names.push_back(objectName);
-    }
-    else
+  void append(const char* name, H5O_type_t type, int64_t creationOrder)
+  {
+    m_Offsets.push_back(m_Names.size());
+    m_Names.insert(m_Names.end(), name, name + std::strlen(name) + 1);
+    m_Types.push_back(type);
+    m_CreationOrder.push_back(creationOrder);
+  }
+
+private:
+  std::vector<char> m_Names;
+  std::vector<size_t> m_Offsets;
+  std::vector<H5O_type_t> m_Types;
+  std::vector<int64_t> m_CreationOrder;
+};
+
+/**
+ * @brief Signature of the function called by iterateGroup for every member: the member name, the type of
+ * the object it links to and its creation order (-1 if not tracked). Return 0 to continue, a positive value
+ * to stop or a negative value to stop with an error. An exception thrown by the visitor also stops the
+ * iteration and is rethrown by iterateGroup once H5Literate has returned.
+ */
+using GroupVisitor = std::function<herr_t(const char* name, H5O_type_t type, int64_t creationOrder)>;
+
+namespace detail
+{
+struct GroupIterationData
+{
+  const GroupVisitor* visitor = nullptr;
+  bool resolveTypes = true;
+  std::exception_ptr exception;
+};
+
+inline herr_t visitLink(hid_t groupID, const char* name, const H5L_info_t* info, void* opData)
+{
+  auto* data = static_cast<GroupIterationData*>(opData);
+  H5O_type_t type = H5O_TYPE_UNKNOWN;
+  if(data->resolveTypes && info->type != H5L_TYPE_EXTERNAL)
+  {
+    H5O_info_t objectInfo{};
+#if H5_VERSION_GE(1, 10, 3)
+    // Only the basic fields: the type does not need the attribute count or header statistics
+    herr_t error = H5Oget_info_by_name2(groupID, name, &objectInfo, H5O_INFO_BASIC, H5P_DEFAULT);
+#else
+    herr_t error = H5Oget_info_by_name(groupID, name, &objectInfo, H5P_DEFAULT);
+#endif
+    if(error >= 0)
     {
-      H5O_info_t objectInfo{};
-      error = H5Oget_info_by_name(locationID, name.data(), &objectInfo, H5P_DEFAULT);
-      if(error >= 0)
-      {
-        type = objectInfo.type;
-        if(((type == H5O_TYPE_GROUP) && ((static_cast<int32_t>(CustomHDFDataTypes::Group) & static_cast<int32_t>(typeFilter)) != 0)) ||
-           ((type == H5O_TYPE_DATASET) && ((static_cast<int32_t>(CustomHDFDataTypes::Dataset) & static_cast<int32_t>(typeFilter)) != 0)))
-        {
-          std::string objectName(name.data());
-          names.push_back(objectName);
-        }
-      }
+      type = objectInfo.type;
     }
   }
+  // Exceptions must not unwind through the HDF5 C library; keep it and stop the iteration instead
+  try
+  {
+    return (*data->visitor)(name, type, info->corder_valid ? static_cast<int64_t>(info->corder) : -1);
+  } catch(...)
+  {
+    data->exception = std::current_exception();
+    return -1;
+  }
+}
+} // namespace detail
 
+/**
+ * @brief Calls visitor for every member of a group in a single H5Literate pass.
+ * @param locationID The group (or file) to list
+ * @param visitor Called for every member
+ * @param resolveTypes Look up the type of the object each link points to. Without it every type is
+ * H5O_TYPE_UNKNOWN and no object headers are read.
+ * @param indexType H5_INDEX_NAME or H5_INDEX_CRT_ORDER. The latter needs a group that tracks creation order.
+ * @return Negative value on error, the positive value returned by visitor if it stopped the iteration, 0 otherwise.
+ * If visitor throws, the iteration stops and the exception is rethrown here after H5Literate returns.
+ */
+inline herr_t iterateGroup(hid_t locationID, const GroupVisitor& visitor, bool resolveTypes = true, H5_index_t indexType = H5_INDEX_NAME)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  detail::GroupIterationData data;
+  data.visitor = &visitor;
+  data.resolveTypes = resolveTypes;
+  hsize_t index = 0;
+  herr_t error = H5Literate(locationID, indexType, H5_ITER_INC, &index, detail::visitLink, &data);
+  if(data.exception)
+  {
+    std::rethrow_exception(data.exception);
+  }
   return error;
 }
 
+/**
+ * @brief Lists the members of a group in a single pass.
+ * @param locationID The group (or file) to list
+ * @param listing Receives the members; anything it held before is cleared
+ * @param typeFilter Only list groups and/or datasets. Any skips looking up the object types.
+ * @param indexType H5_INDEX_NAME or H5_INDEX_CRT_ORDER. The latter needs a group that tracks creation order.
+ * @return Standard HDF5 error condition
+ */
+inline herr_t listGroup(hid_t locationID, GroupListing& listing, CustomHDFDataTypes typeFilter = CustomHDFDataTypes::Any, H5_index_t indexType = H5_INDEX_NAME)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  listing.clear();
+  H5G_info_t groupInfo{};
+  herr_t error = H5Gget_info(locationID, &groupInfo);
+  if(error < 0)
+  {
+    return error;
+  }
+  listing.reserve(static_cast<size_t>(groupInfo.nlinks));
+
+  const bool any = typeFilter == CustomHDFDataTypes::Any;
+  const bool groups = (static_cast<int32_t>(CustomHDFDataTypes::Group) & static_cast<int32_t>(typeFilter)) != 0;
+  const bool datasets = (static_cast<int32_t>(CustomHDFDataTypes::Dataset) & static_cast<int32_t>(typeFilter)) != 0;
+  GroupVisitor visitor = [&](const char* name, H5O_type_t type, int64_t creationOrder) -> herr_t {
+    if(any || (type == H5O_TYPE_GROUP && groups) || (type == H5O_TYPE_DATASET && datasets))
+    {
+      listing.append(name, type, creationOrder);
+    }
+    return 0;
+  };
+  error = iterateGroup(locationID, visitor, !any, indexType);
+  return error < 0 ? error : 0;
+}
+
+/**
+ * @brief Returns a list of child hdf5 objects for a given object id
+ * @param locationID The parent hdf5 id
+ * @param typeFilter A filter to apply to the list
+ * @param names Variable to store the list
+ * @return
+ */
+inline herr_t getGroupObjects(hid_t locationID, CustomHDFDataTypes typeFilter, std::list<std::string>& names)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  GroupListing listing;
+  herr_t error = listGroup(locationID, listing, typeFilter);
+  if(error < 0)
+  {
+    return error;
+  }
+  for(size_t i = 0; i < listing.size(); i++)
+  {
+    names.emplace_back(listing.getName(i));
+  }
+  return 0;
+}
+
 /**
  * @brief Creates a HDF Group by checking if the group already exists. If the
  * group already exists then that group is returned otherwise a new group is
@@ -647,8 +1092,9 @@ inline herr_t getGroupObjects(hid_t locationID, CustomHDFDataTypes typeFilter, s
  * @param locationID The HDF unique id given to files or groups
  * @param group The name of the group to create. Note that this group name should
  * not be any sort of 'path'. It should be a single group.
+ * @param options Creation order and link storage settings used if the group is created
  */
-inline hid_t createGroup(hid_t locationID, const std::string& group)
+inline hid_t createGroup(hid_t locationID, const std::string& group, const GroupCreateOptions& options)
 {
   H5SUPPORT_MUTEX_LOCK()
 
@@ -663,113 +1109,151 @@ inline hid_t createGroup(hid_t locationID, const std::string& group)
   {
     groupID = H5Gopen(locationID, group.c_str(), H5P_DEFAULT);
   }
-  else
+  else if(options.isDefault())
   {
     groupID = H5Gcreate(locationID, group.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
   }
+  else
+  {
+    PropertyListHandle groupCreatePropertyList(options.createPropertyList());
+    if(groupCreatePropertyList.isValid())
+    {
+      groupID = H5Gcreate(locationID, group.c_str(), H5P_DEFAULT, groupCreatePropertyList.get(), H5P_DEFAULT);
+    }
+  }
   // Turn the HDF Error handlers back on
   HDF_ERROR_HANDLER_ON
 
   return groupID;
 }
 
+/**
+ * @brief Creates a HDF Group by checking if the group already exists. If the
+ * group already exists then that group is returned otherwise a new group is
+ * created.
+ * @param locationID The HDF unique id given to files or groups
+ * @param group The name of the group to create. Note that this group name should
+ * not be any sort of 'path'. It should be a single group.
+ */
+inline hid_t createGroup(hid_t locationID, const std::string& group)
+{
+  return createGroup(locationID, group, GroupCreateOptions());
+}
+
 /**
  * @brief Given a path relative to the Parent ID, this method will create all
- * the intermediate groups if necessary.
+ * the intermediate groups if necessary. With default options the missing groups are created
+ * by HDF5 in a single call. If the H5GroupPathCache is enabled for the file, paths that are
+ * already known to exist return without touching the file.
  * @param pathToCheck The path to either create or ensure exists.
  * @param parent The HDF unique id for the parent
+ * @param options Creation order and link storage settings used for every group that gets created
  * @return Error Condition: Negative is error. Positive is success.
  */
-inline hid_t createGroupsFromPath(const std::string& pathToCheck, hid_t parent)
+inline hid_t createGroupsFromPath(const std::string& pathToCheck, hid_t parent, const GroupCreateOptions& options)
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  hid_t groupID = 1;
-  herr_t error = -1;
-  std::string first;
-  std::string second;
-  std::string path(pathToCheck); // make a copy of the input
-
   if(parent <= 0)
   {
     std::cout << "Bad parent Id. Returning from createGroupsFromPath" << std::endl;
     return -1;
   }
-  // remove any front slash
-  std::string::size_type pos = path.find_first_of('/', 0);
-  if(0 == pos)
+  // Remove any leading and trailing slashes
+  std::string::size_type first = pathToCheck.find_first_not_of('/');
+  if(first == std::string::npos)
   {
-    path = path.substr(1, path.size());
-  }
-  else if(pos == std::string::npos) // Path contains only one element
-  {
-    groupID = H5Utilities::createGroup(parent, path);
-    if(groupID < 0)
-    {
-      std::cout << "Error creating group: " << path << " err:" << groupID << std::endl;
-      return groupID;
-    }
-    error = H5Gclose(groupID);
-    if(error < 0)
-    {
-      std::cout << "Error closing group during group creation." << std::endl;
-      return error;
-    }
-    return error; // Now return here as this was a special case.
-  }
-
-  // Remove any trailing slash
-  pos = path.find_last_of('/');
-  if(pos == (path.size() - 1)) // slash was in the last position
-  {
-    path = path.substr(0, pos);
+    return -1; // The path that was passed in was only a slash..
   }
+  std::string path = pathToCheck.substr(first, pathToCheck.find_last_not_of('/') - first + 1);
 
-  if(path.empty())
+  if(H5GroupPathCache::contains(parent, path))
   {
-    return -1; // The path that was passed in was only a slash..
+    return 0;
   }
 
-  pos = path.find_first_of('/', 0);
-  if(pos == std::string::npos) // Only one element in the path
+  H5O_info_t objectInfo{};
+  HDF_ERROR_HANDLER_OFF
+  herr_t error = H5Oget_info_by_name(parent, path.c_str(), &objectInfo, H5P_DEFAULT);
+  HDF_ERROR_HANDLER_ON
+  if(error >= 0)
   {
-    groupID = H5Utilities::createGroup(parent, path);
-    if(groupID < 0)
+    if(objectInfo.type != H5O_TYPE_GROUP)
     {
-      std::cout << "Error creating group '" << path << "' for group id " << groupID << std::endl;
-      return groupID;
+      std::cout << "Error creating group '" << path << "': an object that is not a group already exists there" << std::endl;
+      return -1;
     }
-    error = H5Gclose(groupID);
-    return error;
+    H5GroupPathCache::insert(parent, path);
+    return 0;
   }
 
-  while(pos != std::string::npos)
+  if(!options.isDefault())
   {
-    first = path.substr(0, pos);
-    second = path.substr(pos + 1, path.length());
-    groupID = H5Utilities::createGroup(parent, first);
-    if(groupID < 0)
+    // HDF5 creates intermediate groups with the default creation properties, so each missing group gets
+    // created here with the options applied
+    PropertyListHandle groupCreatePropertyList(options.createPropertyList());
+    if(!groupCreatePropertyList.isValid())
     {
-      std::cout << "Error creating group:" << groupID << std::endl;
-      return groupID;
+      return -1;
     }
-    error = H5Gclose(groupID);
-    pos = path.find_first_of('/', pos + 1);
-    if(pos == std::string::npos)
+    std::string::size_type slash = 0;
+    while(slash != std::string::npos)
     {
-      first += "/" + second;
-      groupID = createGroup(parent, first);
-      if(groupID < 0)
+      slash = path.find('/', slash + 1);
+      std::string groupPath = path.substr(0, slash);
+      HDF_ERROR_HANDLER_OFF
+      htri_t exists = H5Lexists(parent, groupPath.c_str(), H5P_DEFAULT);
+      HDF_ERROR_HANDLER_ON
+      if(exists > 0)
+      {
+        continue;
+      }
+      GroupHandle group(H5Gcreate(parent, groupPath.c_str(), H5P_DEFAULT, groupCreatePropertyList.get(), H5P_DEFAULT));
+      if(!group.isValid())
       {
-        std::cout << "Error creating group:" << groupID << std::endl;
-        return groupID;
+        std::cout << "Error creating group '" << groupPath << "' for group id " << parent << std::endl;
+        return group.get();
       }
-      error = H5Gclose(groupID);
     }
+    H5GroupPathCache::insert(parent, path);
+    return 0;
+  }
+
+  // Let HDF5 create every missing group along the path in the same call
+  PropertyListHandle linkCreatePropertyList(H5Pcreate(H5P_LINK_CREATE));
+  if(!linkCreatePropertyList.isValid() || H5Pset_create_intermediate_group(linkCreatePropertyList.get(), 1) < 0)
+  {
+    std::cout << "Error creating the link creation property list" << std::endl;
+    return -1;
+  }
+  GroupHandle group(H5Gcreate(parent, path.c_str(), linkCreatePropertyList.get(), H5P_DEFAULT, H5P_DEFAULT));
+  if(!group.isValid())
+  {
+    std::cout << "Error creating group '" << path << "' for group id " << parent << std::endl;
+    return group.get();
+  }
+  error = group.close();
+  if(error < 0)
+  {
+    std::cout << "Error closing group during group creation." << std::endl;
+    return error;
   }
+  H5GroupPathCache::insert(parent, path);
   return error;
 }
 
+/**
+ * @brief Given a path relative to the Parent ID, this method will create all
+ * the intermediate groups if necessary.
+ * @param pathToCheck The path to either create or ensure exists.
+ * @param parent The HDF unique id for the parent
+ * @return Error Condition: Negative is error. Positive is success.
+ */
+inline hid_t createGroupsFromPath(const std::string& pathToCheck, hid_t parent)
+{
+  return createGroupsFromPath(pathToCheck, parent, GroupCreateOptions());
+}
+
 /**
  * @brief Given a path relative to the Parent ID, this method will create all
  * the intermediate groups if necessary.
@@ -801,13 +1285,7 @@ inline hid_t createGroupsForDataset(const std::string& datasetPath, hid_t parent
  */
 inline std::string extractObjectName(const std::string& path)
 {
-  std::string::size_type pos;
-  pos = path.find_last_of('/');
-  if(pos == std::string::npos || path == "/")
-  {
-    return path;
-  }
-  return path.substr(pos + 1);
+  return std::string(H5Path::objectName(path));
 }
 
 // -------------- HDF Attribute Methods ----------------------------
@@ -822,12 +1300,10 @@ inline bool probeForAttribute(hid_t locationID, const std::string& objectName, c
 {
   H5SUPPORT_MUTEX_LOCK()
 
-  herr_t error = 0;
-  hid_t rank;
   HDF_ERROR_HANDLER_OFF
-  error = H5Lite::getAttributeNDims(locationID, objectName, attributeName, rank);
+  htri_t exists = H5Aexists_by_name(locationID, objectName.c_str(), attributeName.c_str(), H5P_DEFAULT);
   HDF_ERROR_HANDLER_ON
-  return error >= 0;
+  return exists > 0;
 }
 
 /**
@@ -844,24 +1320,26 @@ inline herr_t getAllAttributeNames(hid_t objectID, std::list<std::string>& resul
   {
     return -1;
   }
-  herr_t error = -1;
-  hsize_t numAttributes;
-  hid_t attributeID;
-  size_t nameSize;
   H5O_info_t objectInfo{};
-  error = H5Oget_info(objectID, &objectInfo);
-  numAttributes = objectInfo.num_attrs;
+  herr_t error = H5Oget_info(objectID, &objectInfo);
+  if(error < 0)
+  {
+    return error;
+  }
 
   std::vector<char> attributeName;
-
-  for(hsize_t i = 0; i < numAttributes; i++)
+  for(hsize_t i = 0; i < objectInfo.num_attrs; i++)
   {
-    attributeID = H5Aopen_by_idx(objectID, ".", H5_INDEX_NAME, H5_ITER_INC, i, H5P_DEFAULT, H5P_DEFAULT);
-    nameSize = 1 + H5Aget_name(attributeID, 0, nullptr);
+    AttributeHandle attribute(H5Aopen_by_idx(objectID, ".", H5_INDEX_NAME, H5_ITER_INC, i, H5P_DEFAULT, H5P_DEFAULT));
+    if(!attribute.isValid())
+    {
+      return static_cast<herr_t>(attribute.get());
+    }
+    size_t nameSize = 1 + H5Aget_name(attribute.get(), 0, nullptr);
     attributeName.resize(nameSize, 0);
-    H5Aget_name(attributeID, nameSize, attributeName.data());
+    H5Aget_name(attribute.get(), nameSize, attributeName.data());
     results.emplace_back(attributeName.data());
-    error = H5Aclose(attributeID);
+    error = attribute.close();
   }
 
   return error;
@@ -876,20 +1354,19 @@ inline herr_t getAllAttributeNames(hid_t objectID, std::list<std::string>& resul
  */
 inline herr_t getAllAttributeNames(hid_t locationID, const std::string& objectName, std::list<std::string>& names)
 {
-
-  hid_t objectID = -1;
-  herr_t error = -1;
   names.clear();
 
-  objectID = openHDF5Object(locationID, objectName);
-  if(objectID < 0)
+  ObjectHandle object(openHDF5Object(locationID, objectName));
+  if(!object.isValid())
   {
-    return static_cast<herr_t>(objectID);
+    return static_cast<herr_t>(object.get());
   }
-  error = getAllAttributeNames(objectID, names);
-  error = closeHDF5Object(objectID);
-
-  return error;
+  herr_t error = getAllAttributeNames(object.get(), names);
+  if(error < 0)
+  {
+    return error;
+  }
+  return object.close();
 }
 
 }; // namespace H5Utilities
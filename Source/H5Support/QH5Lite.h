@@ -272,12 +272,13 @@ inline herr_t writePointerDataset(hid_t locationID, const QString& datasetName,
  * @param rank The number of dimensions
  * @param dims The sizes of each dimension
  * @param data The data to be written.
+ * @param mode What to do when the existing dataset has a different shape or type
  * @return Standard hdf5 error condition.
  */
 template <typename T>
-inline herr_t replacePointerDataset(hid_t locationID, const QString& datasetName, int32_t rank, const hsize_t* dims, const T* data)
+inline herr_t replacePointerDataset(hid_t locationID, const QString& datasetName, int32_t rank, const hsize_t* dims, const T* data, H5Lite::ReplaceMode mode = H5Lite::ReplaceMode::InPlace)
 {
-  return H5Lite::replacePointerDataset(locationID, datasetName.toStdString(), rank, dims, data);
+  return H5Lite::replacePointerDataset(locationID, datasetName.toStdString(), rank, dims, data, mode);
 }
 
 /**
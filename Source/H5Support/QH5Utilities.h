@@ -70,6 +70,18 @@ inline hid_t openFile(const QString& filename, bool readOnly = false)
   return H5Utilities::openFile(filename.toStdString(), readOnly);
 }
 
+/**
+ * @brief Opens a H5 file at path filename with the given file access options. Returns the id of the file object.
+ * @param filename
+ * @param readOnly
+ * @param options
+ * @return
+ */
+inline hid_t openFile(const QString& filename, bool readOnly, const FileAccessOptions& options)
+{
+  return H5Utilities::openFile(filename.toStdString(), readOnly, options);
+}
+
 /**
  * @brief Creates a H5 file at path filename. Returns the id of the file object.
  * @param filename
@@ -80,6 +92,17 @@ inline hid_t createFile(const QString& filename)
   return H5Utilities::createFile(filename.toStdString());
 }
 
+/**
+ * @brief Creates a H5 file at path filename with the given file access options. Returns the id of the file object.
+ * @param filename
+ * @param options
+ * @return
+ */
+inline hid_t createFile(const QString& filename, const FileAccessOptions& options)
+{
+  return H5Utilities::createFile(filename.toStdString(), options);
+}
+
 /**
  * @brief Closes a H5 file object. Returns the H5 error code.
  * @param fileID
@@ -32,12 +32,23 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <array>
 #include <cstdio>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 
+#include "H5Support/H5AsyncIO.h"
+#include "H5Support/H5AttributeBatch.h"
+#include "H5Support/H5AttributeSnapshot.h"
+#include "H5Support/H5DatasetTemplate.h"
 #include "H5Support/H5Lite.h"
+#include "H5Support/H5MappedDataset.h"
+#include "H5Support/H5Path.h"
 #include "H5Support/H5Utilities.h"
 
 #include "H5SupportTestHelper.h"
@@ -62,8 +73,16 @@
  * writeStringAttribute - DONE
  * writeStringAttributes - DONE
  * writeScalarAttribute - DONE
+ * writePointerHyperslab - DONE
+ * writeVectorHyperslab - DONE
+ * writePointerDatasetCompressedParallel - DONE
+ * writeVectorDatasetCompressedParallel - DONE
  * readPointerDataset - DONE
  * readVectorDataset - DONE
+ * readPointerHyperslab - DONE
+ * readVectorHyperslab - DONE
+ * readPointerDatasetParallel - DONE
+ * readVectorDatasetParallel - DONE
  * readScalarDataset - DONE
  * readStringDataset - DONE
  * readStringDataset - DONE
@@ -101,6 +120,21 @@ public:
     std::remove(UnitTest::H5LiteTest::FileName.c_str());
     std::remove(UnitTest::H5LiteTest::LargeFile.c_str());
     std::remove(UnitTest::H5LiteTest::VLengthFile.c_str());
+    std::remove(UnitTest::H5LiteTest::HyperslabFile.c_str());
+    std::remove(UnitTest::H5LiteTest::AppendFile.c_str());
+    std::remove(UnitTest::H5LiteTest::ParallelDeflateFile.c_str());
+    std::remove(UnitTest::H5LiteTest::ObjectCacheFile.c_str());
+    std::remove(UnitTest::H5LiteTest::ConcurrentFile.c_str());
+    std::remove(UnitTest::H5LiteTest::AsyncFile.c_str());
+    std::remove(UnitTest::H5LiteTest::MappedFile.c_str());
+    std::remove(UnitTest::H5LiteTest::HandlesFile.c_str());
+    std::remove(UnitTest::H5LiteTest::PathFile.c_str());
+    std::remove(UnitTest::H5LiteTest::AttributeFile.c_str());
+    std::remove(UnitTest::H5LiteTest::ReplaceFile.c_str());
+    std::remove(UnitTest::H5LiteTest::DatasetOptionsFile.c_str());
+    std::remove(UnitTest::H5LiteTest::ExternalRawFile.c_str());
+    std::remove(UnitTest::H5LiteTest::CompactFile.c_str());
+    std::remove(UnitTest::H5LiteTest::TemplateFile.c_str());
 #endif
   }
 
@@ -983,6 +1017,1317 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestHyperslab()
+  {
+    constexpr hsize_t dimZ = 5;
+    constexpr hsize_t dimY = 4;
+    constexpr hsize_t dimX = 3;
+    const std::vector<hsize_t> dims = {dimZ, dimY, dimX};
+    std::vector<int32_t> volume(dimZ * dimY * dimX);
+    std::iota(volume.begin(), volume.end(), 0);
+
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::HyperslabFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    herr_t error = H5Lite::writeVectorDataset(fileID, "Volume", dims, volume);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Read a single Z slice
+    std::vector<int32_t> slice;
+    error = H5Lite::readVectorHyperslab(fileID, "Volume", {2, 0, 0}, {1, dimY, dimX}, slice);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(slice.size() == dimY * dimX);
+    for(size_t i = 0; i < slice.size(); i++)
+    {
+      H5SUPPORT_REQUIRE(slice[i] == volume[2 * dimY * dimX + i]);
+    }
+
+    // Read every other Z slice of a single column using a stride
+    std::vector<int32_t> column;
+    error = H5Lite::readVectorHyperslab(fileID, "Volume", {0, 1, 2}, {2, 1, 1}, {3, 1, 1}, {}, column);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(column.size() == 3);
+    for(size_t z = 0; z < column.size(); z++)
+    {
+      H5SUPPORT_REQUIRE(column[z] == volume[(2 * z) * dimY * dimX + 1 * dimX + 2]);
+    }
+
+    // Overwrite a Z slice and read the whole volume back
+    std::vector<int32_t> newSlice(dimY * dimX, -1);
+    error = H5Lite::writeVectorHyperslab(fileID, "Volume", {4, 0, 0}, {1, dimY, dimX}, newSlice);
+    H5SUPPORT_REQUIRE(error >= 0);
+    std::fill(volume.begin() + 4 * dimY * dimX, volume.end(), -1);
+    std::vector<int32_t> readBack;
+    error = H5Lite::readVectorDataset(fileID, "Volume", readBack);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(readBack == volume);
+
+    // Selections outside of the dataset and mismatched sizes must fail
+    error = H5Lite::readVectorHyperslab(fileID, "Volume", {5, 0, 0}, {1, dimY, dimX}, slice);
+    H5SUPPORT_REQUIRE(error < 0);
+    error = H5Lite::readVectorHyperslab(fileID, "Volume", {0, 0}, {1, dimY, dimX}, slice);
+    H5SUPPORT_REQUIRE(error < 0);
+    error = H5Lite::writeVectorHyperslab(fileID, "Volume", {0, 0, 0}, {2, dimY, dimX}, newSlice);
+    H5SUPPORT_REQUIRE(error < 0);
+
+    // The selection must have as many dimensions as the dataset
+    error = H5Lite::readVectorHyperslab(fileID, "Volume", {2, 0}, {1, dimY}, slice);
+    H5SUPPORT_REQUIRE(error < 0);
+    error = H5Lite::writeVectorHyperslab(fileID, "Volume", {2, 0}, {1, dimY}, newSlice);
+    H5SUPPORT_REQUIRE(error < 0);
+    std::array<hsize_t, 2> start = {2, 0};
+    std::array<hsize_t, 2> count = {1, dimY};
+    error = H5Lite::readPointerHyperslab(fileID, "Volume", 2, start.data(), nullptr, count.data(), nullptr, slice.data());
+    H5SUPPORT_REQUIRE(error < 0);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAppendDataset()
+  {
+    constexpr hsize_t dimY = 4;
+    constexpr hsize_t dimX = 3;
+    constexpr hsize_t frameSize = dimY * dimX;
+    constexpr hsize_t numFrames = 10;
+
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::AppendFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    herr_t error = H5Lite::createExtendibleDataset<uint16_t>(fileID, "Frames", {dimY, dimX}, 4);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::createExtendibleDataset<double>(fileID, "Scalars", {});
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    std::vector<uint16_t> reference;
+    std::vector<uint16_t> frame(frameSize);
+    for(hsize_t f = 0; f < numFrames; f++)
+    {
+      std::iota(frame.begin(), frame.end(), static_cast<uint16_t>(f * frameSize));
+      reference.insert(reference.end(), frame.cbegin(), frame.cend());
+      error = H5Lite::appendVectorDataset(fileID, "Frames", frame);
+      H5SUPPORT_REQUIRE(error >= 0);
+      double value = static_cast<double>(f);
+      error = H5Lite::appendPointerDataset(fileID, "Scalars", 1, &value);
+      H5SUPPORT_REQUIRE(error >= 0);
+    }
+    // Two frames at once
+    std::vector<uint16_t> twoFrames(2 * frameSize, 7);
+    reference.insert(reference.end(), twoFrames.cbegin(), twoFrames.cend());
+    error = H5Lite::appendVectorDataset(fileID, "Frames", twoFrames);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Partial frames and fixed size datasets can not be appended to
+    std::vector<uint16_t> partialFrame(frameSize - 1, 0);
+    error = H5Lite::appendVectorDataset(fileID, "Frames", partialFrame);
+    H5SUPPORT_REQUIRE(error < 0);
+    error = H5Lite::writeVectorDataset(fileID, "Fixed", {frameSize}, frame);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::appendVectorDataset(fileID, "Fixed", frame);
+    H5SUPPORT_REQUIRE(error < 0);
+
+    std::vector<hsize_t> dims;
+    H5T_class_t classType;
+    size_t typeSize = 0;
+    error = H5Lite::getDatasetInfo(fileID, "Frames", dims, classType, typeSize);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(dims == std::vector<hsize_t>({numFrames + 2, dimY, dimX}));
+
+    std::vector<uint16_t> readBack;
+    error = H5Lite::readVectorDataset(fileID, "Frames", readBack);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(readBack == reference);
+
+    std::vector<double> scalars;
+    error = H5Lite::readVectorDataset(fileID, "Scalars", scalars);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(scalars.size() == numFrames);
+    H5SUPPORT_REQUIRE(scalars.back() == static_cast<double>(numFrames - 1));
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestObjectCache()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::ObjectCacheFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    hid_t groupID = H5Utilities::createGroup(fileID, "Group");
+    H5SUPPORT_REQUIRE(groupID > 0);
+    herr_t error = 0;
+    for(int32_t i = 0; i < 3; i++)
+    {
+      error = H5Lite::writeScalarDataset(groupID, "Scalar" + std::to_string(i), i);
+      H5SUPPORT_REQUIRE(error >= 0);
+    }
+    error = H5Lite::writeScalarAttribute(fileID, "/Group/Scalar0", "Attribute", 42.0f);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    H5ObjectCache::Statistics stats;
+    H5SUPPORT_REQUIRE(H5ObjectCache::getStatistics(fileID, stats) < 0);
+    H5SUPPORT_REQUIRE(H5ObjectCache::enable(groupID) < 0);
+    error = H5ObjectCache::enable(fileID, 2);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(H5ObjectCache::isEnabled(fileID));
+
+    // Relative and absolute names of the same dataset share one entry
+    for(int32_t i = 0; i < 3; i++)
+    {
+      int32_t value = -1;
+      error = H5Lite::readScalarDataset(groupID, "Scalar0", value);
+      H5SUPPORT_REQUIRE(error >= 0);
+      H5SUPPORT_REQUIRE(value == 0);
+      error = H5Lite::readScalarDataset(fileID, "/Group/Scalar0", value);
+      H5SUPPORT_REQUIRE(error >= 0);
+      H5SUPPORT_REQUIRE(value == 0);
+    }
+    float attribute = 0.0f;
+    error = H5Lite::readScalarAttribute(groupID, "Scalar0", "Attribute", attribute);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(attribute == 42.0f);
+    error = H5ObjectCache::getStatistics(fileID, stats);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(stats.misses == 1);
+    H5SUPPORT_REQUIRE(stats.hits == 6);
+    H5SUPPORT_REQUIRE(stats.size == 1);
+    H5SUPPORT_REQUIRE(stats.capacity == 2);
+
+    // The cache is bounded
+    int32_t value = -1;
+    H5Lite::readScalarDataset(groupID, "Scalar1", value);
+    H5Lite::readScalarDataset(groupID, "Scalar2", value);
+    H5SUPPORT_REQUIRE(value == 2);
+    H5ObjectCache::getStatistics(fileID, stats);
+    H5SUPPORT_REQUIRE(stats.size == 2);
+    H5SUPPORT_REQUIRE(stats.evictions == 1);
+
+    // Invalidating a group drops everything below it
+    error = H5ObjectCache::invalidate(fileID, "Group");
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5ObjectCache::getStatistics(fileID, stats);
+    H5SUPPORT_REQUIRE(stats.size == 0);
+    H5SUPPORT_REQUIRE(stats.invalidations == 2);
+
+    H5Lite::readScalarDataset(groupID, "Scalar1", value);
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(fileID, H5F_OBJ_DATASET | H5F_OBJ_LOCAL) == 1);
+    H5Gclose(groupID);
+
+    // closeFile releases the cached ids without reporting them as leaked
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(H5F_OBJ_ALL, H5F_OBJ_DATASET) == 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAsyncIO()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::AsyncFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+
+    std::vector<float> source(4096);
+    std::iota(source.begin(), source.end(), 0.0f);
+    std::vector<float> readBack;
+    {
+      AsyncIO asyncIO(2);
+      std::vector<hsize_t> dims = {64, 64};
+      std::future<herr_t> writePointer = asyncIO.writePointerDatasetAsync(fileID, "Pointer", 2, dims.data(), source.data());
+      std::future<herr_t> writeVector = asyncIO.writeVectorDatasetAsync(fileID, "Vector", dims, source);
+      // Requests run in order, so the read sees the finished write
+      std::future<herr_t> read = asyncIO.readVectorDatasetAsync(fileID, "Vector", readBack);
+      H5SUPPORT_REQUIRE(writePointer.get() >= 0);
+      H5SUPPORT_REQUIRE(writeVector.get() >= 0);
+      H5SUPPORT_REQUIRE(read.get() >= 0);
+      H5SUPPORT_REQUIRE(readBack == source);
+
+      std::vector<float> pointerData(source.size(), 0.0f);
+      H5SUPPORT_REQUIRE(asyncIO.readPointerDatasetAsync(fileID, "Pointer", pointerData.data()).get() >= 0);
+      H5SUPPORT_REQUIRE(pointerData == source);
+
+      // Hold the I/O thread so the following requests stay queued, then cancel them
+      std::promise<void> started;
+      std::promise<void> release;
+      std::shared_future<void> released = release.get_future().share();
+      std::future<herr_t> blocker = asyncIO.submit([&started, released]() {
+        started.set_value();
+        released.wait();
+        return 0;
+      });
+      started.get_future().wait();
+      std::future<herr_t> pending0 = asyncIO.writeVectorDatasetAsync(fileID, "Cancelled0", {4}, std::vector<int32_t>(4, 1));
+      std::future<herr_t> pending1 = asyncIO.writeVectorDatasetAsync(fileID, "Cancelled1", {4}, std::vector<int32_t>(4, 1));
+      H5SUPPORT_REQUIRE(asyncIO.cancelPending() == 2);
+      H5SUPPORT_REQUIRE(pending0.get() == AsyncIO::k_Cancelled);
+      H5SUPPORT_REQUIRE(pending1.get() == AsyncIO::k_Cancelled);
+      release.set_value();
+      H5SUPPORT_REQUIRE(blocker.get() == 0);
+
+      // A throwing task hands its exception to the future and the thread keeps working
+      std::future<herr_t> throwing = asyncIO.submit([]() -> herr_t { throw std::runtime_error("Task failed"); });
+      bool caught = false;
+      try
+      {
+        throwing.get();
+      } catch(const std::runtime_error&)
+      {
+        caught = true;
+      }
+      H5SUPPORT_REQUIRE(caught);
+
+      std::future<herr_t> last = asyncIO.writeVectorDatasetAsync(fileID, "Last", {4}, std::vector<int32_t>(4, 2));
+      asyncIO.waitForIdle();
+      H5SUPPORT_REQUIRE(asyncIO.getPendingCount() == 0);
+      H5SUPPORT_REQUIRE(last.get() >= 0);
+    }
+    H5SUPPORT_REQUIRE(H5Lite::datasetExists(fileID, "Last"));
+    H5SUPPORT_REQUIRE(!H5Lite::datasetExists(fileID, "Cancelled0"));
+
+    herr_t error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMapDataset()
+  {
+    std::vector<double> data(64 * 1024);
+    for(size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<double>(i) * 0.25;
+    }
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::MappedFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    herr_t error = H5Lite::writeVectorDataset(fileID, "Contiguous", {256, 256}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorDatasetCompressed(fileID, "Compressed", {256, 256}, data, {64, 64}, 1);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Files open for writing are never mapped
+    MappedDataset<double> view;
+    error = H5Lite::mapDataset(fileID, "Contiguous", view);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(!view.isMapped());
+    H5SUPPORT_REQUIRE(std::equal(view.begin(), view.end(), data.begin(), data.end()));
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    fileID = H5Utilities::openFile(UnitTest::H5LiteTest::MappedFile, true);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    error = H5Lite::mapDataset(fileID, "Contiguous", view);
+    H5SUPPORT_REQUIRE(error >= 0);
+#ifdef H5Support_HAVE_MMAP
+    H5SUPPORT_REQUIRE(view.isMapped());
+#endif
+    H5SUPPORT_REQUIRE(view.getDims() == std::vector<hsize_t>({256, 256}));
+    H5SUPPORT_REQUIRE(view.size() == data.size());
+    H5SUPPORT_REQUIRE(std::equal(view.begin(), view.end(), data.begin(), data.end()));
+
+    // Filtered data and type conversions fall back to a copy
+    MappedDataset<double> compressed;
+    error = H5Lite::mapDataset(fileID, "Compressed", compressed);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(!compressed.isMapped());
+    H5SUPPORT_REQUIRE(std::equal(compressed.begin(), compressed.end(), data.begin(), data.end()));
+    MappedDataset<float> converted;
+    error = H5Lite::mapDataset(fileID, "Contiguous", converted);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(!converted.isMapped());
+    H5SUPPORT_REQUIRE(converted[8] == 2.0f);
+    error = H5Lite::mapDataset(fileID, "DoesNotExist", converted);
+    H5SUPPORT_REQUIRE(error < 0);
+    H5SUPPORT_REQUIRE(converted.empty());
+
+    // The mapping outlives the file and can be moved
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    MappedDataset<double> moved = std::move(view);
+    H5SUPPORT_REQUIRE(view.empty());
+    H5SUPPORT_REQUIRE(moved[data.size() - 1] == data.back());
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestHandles()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::HandlesFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+
+    GroupHandle group(H5Gcreate(fileID, "Group", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+    H5SUPPORT_REQUIRE(group.isValid());
+    hid_t groupID = group.get();
+    GroupHandle moved(std::move(group));
+    H5SUPPORT_REQUIRE(!group);
+    H5SUPPORT_REQUIRE(moved.get() == groupID);
+    H5SUPPORT_REQUIRE(group.close() == 0);
+    H5SUPPORT_REQUIRE(moved.close() >= 0);
+    H5SUPPORT_REQUIRE(H5Iis_valid(groupID) <= 0);
+
+    hid_t firstSpaceID = -1;
+    hid_t secondSpaceID = -1;
+    {
+      DataspaceHandle dataspace(H5Screate(H5S_SCALAR));
+      H5SUPPORT_REQUIRE(dataspace.isValid());
+      firstSpaceID = dataspace.get();
+      dataspace.reset(H5Screate(H5S_SCALAR));
+      secondSpaceID = dataspace.get();
+      H5SUPPORT_REQUIRE(H5Iis_valid(firstSpaceID) <= 0);
+      groupID = H5Gopen(fileID, "Group", H5P_DEFAULT);
+      GroupHandle released(groupID);
+      H5SUPPORT_REQUIRE(released.release() == groupID);
+      H5SUPPORT_REQUIRE(!released.isValid());
+    }
+    H5SUPPORT_REQUIRE(H5Iis_valid(secondSpaceID) <= 0);
+    H5SUPPORT_REQUIRE(H5Iis_valid(groupID) > 0);
+    H5Gclose(groupID);
+
+    // Failed reads and writes leave nothing open behind them
+    std::vector<int32_t> data(10, 7);
+    herr_t error = H5Lite::writeVectorDataset(fileID, "Data", {10}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorAttribute(fileID, "Data", "Attribute", {10}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    std::vector<int32_t> read;
+    error = H5Lite::readVectorAttribute(fileID, "Data", "Attribute", read);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(read == data);
+    error = H5Lite::readVectorAttribute(fileID, "Data", "DoesNotExist", read);
+    H5SUPPORT_REQUIRE(error < 0);
+    std::vector<hsize_t> start = {8};
+    std::vector<hsize_t> count = {4};
+    error = H5Lite::writeVectorHyperslab(fileID, "Data", start, count, data);
+    H5SUPPORT_REQUIRE(error < 0);
+    error = H5Lite::readVectorDataset(fileID, "DoesNotExist", read);
+    H5SUPPORT_REQUIRE(error < 0);
+    std::string text;
+    error = H5Lite::writeStringDataset(fileID, "Text", std::string("Handles"));
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::readStringDataset(fileID, "DoesNotExist", text);
+    H5SUPPORT_REQUIRE(error < 0);
+    error = H5Lite::readStringAttribute(fileID, "Text", "DoesNotExist", text);
+    H5SUPPORT_REQUIRE(text.empty());
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(fileID, H5F_OBJ_ALL | H5F_OBJ_LOCAL) == 1);
+
+    // Handles the caller holds stay usable after closeFile
+    DatasetHandle dataset(H5Dopen(fileID, "Data", H5P_DEFAULT));
+    H5SUPPORT_REQUIRE(dataset.isValid());
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    read.assign(10, 0);
+    error = H5Dread(dataset.get(), H5T_NATIVE_INT32, H5S_ALL, H5S_ALL, H5P_DEFAULT, read.data());
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(read == data);
+    H5SUPPORT_REQUIRE(dataset.close() >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestPaths()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::PathFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    herr_t error = static_cast<herr_t>(H5Utilities::createGroupsFromPath("/Some/Deeply/Nested/Group", fileID));
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // The same calls work with an H5Path, a const char* and a std::string
+    H5Path datasetPath("/Some/Deeply/Nested/Group");
+    datasetPath.append("Value");
+    H5SUPPORT_REQUIRE(datasetPath.str() == "/Some/Deeply/Nested/Group/Value");
+    H5SUPPORT_REQUIRE(datasetPath.getObjectName() == "Value");
+    H5SUPPORT_REQUIRE(datasetPath.getParentPath() == "/Some/Deeply/Nested/Group");
+    error = H5Lite::writeScalarDataset(fileID, datasetPath, 42);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(H5Lite::datasetExists(fileID, datasetPath));
+    H5Path attributeName("Units");
+    error = H5Lite::writeScalarAttribute(fileID, datasetPath, attributeName, 1.5f);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    int32_t value = 0;
+    error = H5Lite::readScalarDataset(fileID, datasetPath, value);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(value == 42);
+    value = 0;
+    error = H5Lite::readScalarDataset(fileID, "/Some/Deeply/Nested/Group/Value", value);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(value == 42);
+    value = 0;
+    error = H5Lite::readPointerDataset(fileID, datasetPath.str(), &value);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(value == 42);
+    float units = 0.0f;
+    error = H5Lite::readScalarAttribute(fileID, datasetPath, attributeName, units);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(units == 1.5f);
+    units = 0.0f;
+    error = H5Lite::readPointerAttribute(fileID, datasetPath.c_str(), "Units", &units);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(units == 1.5f);
+
+    // A path built from a string_view, reused for every member of a group
+    std::string_view groupPath = datasetPath.getParentPath();
+    H5Path memberPath;
+    for(int32_t i = 0; i < 3; i++)
+    {
+      memberPath.assign(groupPath).append("Member" + std::to_string(i));
+      error = H5Lite::writeScalarDataset(fileID, memberPath, i);
+      H5SUPPORT_REQUIRE(error >= 0);
+    }
+    error = H5Lite::readScalarDataset(fileID, H5Path(memberPath.view()), value);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(value == 2);
+
+    hid_t datasetID = H5Dopen(fileID, datasetPath.c_str(), H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(datasetID > 0);
+    H5Path objectPath;
+    error = H5Utilities::getObjectPath(datasetID, objectPath);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(objectPath == datasetPath);
+    H5Dclose(datasetID);
+
+    H5SUPPORT_REQUIRE(H5Utilities::getParentPath("Value").empty());
+    H5SUPPORT_REQUIRE(H5Utilities::getParentPath("/Group/Value") == "/Group");
+    H5SUPPORT_REQUIRE(H5Utilities::extractObjectName("/Group/Value") == "Value");
+    H5SUPPORT_REQUIRE(H5Utilities::extractObjectName("/") == "/");
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAttributeBatch()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::AttributeFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    std::vector<int32_t> data(12, 3);
+    herr_t error = H5Lite::writeVectorDataset(fileID, "Data", {3, 4}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    AttributeBatch badBatch(fileID, "DoesNotExist");
+    H5SUPPORT_REQUIRE(!badBatch.isValid());
+    H5SUPPORT_REQUIRE(badBatch.writeScalar("Count", 1) < 0);
+    H5SUPPORT_REQUIRE(badBatch.close() < 0);
+
+    {
+      AttributeBatch batch(fileID, "Data");
+      H5SUPPORT_REQUIRE(batch.isValid());
+      H5SUPPORT_REQUIRE(batch.writeScalar("Count", 12) >= 0);
+      H5SUPPORT_REQUIRE(batch.writeVector("Spacing", {3}, std::vector<float>{0.5f, 0.5f, 1.0f}) >= 0);
+      H5SUPPORT_REQUIRE(batch.writeString("Units", "mm") >= 0);
+      H5SUPPORT_REQUIRE(batch.writeStrings({{"Name", "Image"}, {"Source", "Scanner"}}) >= 0);
+      H5SUPPORT_REQUIRE(batch.close() >= 0);
+      H5SUPPORT_REQUIRE(!batch.isValid());
+    }
+    H5O_info_t objectInfo{};
+    H5Oget_info_by_name(fileID, "Data", &objectInfo, H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(objectInfo.num_attrs == 5);
+
+    int32_t count = 0;
+    error = H5Lite::readScalarAttribute(fileID, "Data", "Count", count);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(count == 12);
+    std::vector<float> spacing;
+    error = H5Lite::readVectorAttribute(fileID, "Data", "Spacing", spacing);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(spacing.size() == 3 && spacing[2] == 1.0f);
+    std::string value;
+    error = H5Lite::readStringAttribute(fileID, "Data", "Source", value);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(value == "Scanner");
+
+    // Attributes of the same type and shape are overwritten, anything else is replaced
+    {
+      AttributeBatch batch(fileID, "Data");
+      H5SUPPORT_REQUIRE(batch.writeScalar("Count", 13) >= 0);
+      H5SUPPORT_REQUIRE(batch.writeVector("Spacing", {2}, std::vector<double>{0.25, 0.75}) >= 0);
+      H5SUPPORT_REQUIRE(batch.writeString("Units", "nm") >= 0);
+      H5SUPPORT_REQUIRE(batch.writeString("Name", "A Longer Name") >= 0);
+      H5SUPPORT_REQUIRE(batch.getError() == 0);
+    }
+    H5Oget_info_by_name(fileID, "Data", &objectInfo, H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(objectInfo.num_attrs == 5);
+    error = H5Lite::readScalarAttribute(fileID, "Data", "Count", count);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(count == 13);
+    std::vector<double> newSpacing;
+    error = H5Lite::readVectorAttribute(fileID, "Data", "Spacing", newSpacing);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(newSpacing.size() == 2 && newSpacing[1] == 0.75);
+    error = H5Lite::readStringAttribute(fileID, "Data", "Units", value);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(value == "nm");
+    error = H5Lite::readStringAttribute(fileID, "Data", "Name", value);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(value == "A Longer Name");
+
+    error = H5Lite::writeStringAttributes(fileID, "Data", {{"Name", "Image"}, {"Units", "um"}});
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::readStringAttribute(fileID, "Data", "Units", value);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(value == "um");
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(fileID, H5F_OBJ_ALL | H5F_OBJ_LOCAL) == 1);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAttributeSnapshot()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::AttributeFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    std::vector<int32_t> data(12, 3);
+    herr_t error = H5Lite::writeVectorDataset(fileID, "Data", {3, 4}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    {
+      AttributeBatch batch(fileID, "Data");
+      batch.writeScalar("Count", int64_t(-12));
+      batch.writeScalar("Flag", uint8_t(1));
+      batch.writeVector("Spacing", {3}, std::vector<float>{0.5f, 0.5f, 1.0f});
+      batch.writeVector("Origin", {2}, std::vector<double>{1.0, 2.0});
+      batch.writeString("Units", "mm");
+      H5SUPPORT_REQUIRE(batch.close() >= 0);
+    }
+    // A variable length string array attribute
+    hid_t datasetID = H5Dopen(fileID, "Data", H5P_DEFAULT);
+    hid_t stringType = H5Tcopy(H5T_C_S1);
+    H5Tset_size(stringType, H5T_VARIABLE);
+    hsize_t numStrings = 2;
+    hid_t dataspaceID = H5Screate_simple(1, &numStrings, nullptr);
+    hid_t attributeID = H5Acreate(datasetID, "Labels", stringType, dataspaceID, H5P_DEFAULT, H5P_DEFAULT);
+    std::array<const char*, 2> labels = {"Phase", "Grain Boundary"};
+    error = H5Awrite(attributeID, stringType, labels.data());
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5Aclose(attributeID);
+    H5Sclose(dataspaceID);
+    H5Tclose(stringType);
+
+    AttributeSnapshot snapshot;
+    error = snapshot.read(fileID, "DoesNotExist");
+    H5SUPPORT_REQUIRE(error < 0);
+    H5SUPPORT_REQUIRE(snapshot.size() == 0);
+    error = snapshot.read(fileID, "Data");
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(snapshot.size() == 6);
+    H5SUPPORT_REQUIRE(snapshot.getName(0) == "Count");
+    H5SUPPORT_REQUIRE(snapshot.getName(5) == "Units");
+    H5SUPPORT_REQUIRE(!snapshot.contains("DoesNotExist"));
+
+    int64_t count = 0;
+    H5SUPPORT_REQUIRE(snapshot.getScalar("Count", count) >= 0);
+    H5SUPPORT_REQUIRE(count == -12);
+    int32_t wrongType = 0;
+    H5SUPPORT_REQUIRE(snapshot.getScalar("Count", wrongType) < 0);
+    H5SUPPORT_REQUIRE(std::get<uint8_t>(snapshot.getValue("Flag")) == 1);
+    std::vector<float> spacing;
+    H5SUPPORT_REQUIRE(snapshot.getVector("Spacing", spacing) >= 0);
+    H5SUPPORT_REQUIRE(spacing == std::vector<float>({0.5f, 0.5f, 1.0f}));
+    H5SUPPORT_REQUIRE(std::get<double>(snapshot.getValue("Origin", 1)) == 2.0);
+    std::vector<hsize_t> dims;
+    H5SUPPORT_REQUIRE(snapshot.getDims("Origin", dims) >= 0);
+    H5SUPPORT_REQUIRE(dims == std::vector<hsize_t>({2}));
+    std::string units;
+    H5SUPPORT_REQUIRE(snapshot.getString("Units", units) >= 0);
+    H5SUPPORT_REQUIRE(units == "mm");
+    H5SUPPORT_REQUIRE(std::get<std::string_view>(snapshot.getValue("Labels", 0)) == "Phase");
+    H5SUPPORT_REQUIRE(std::get<std::string_view>(snapshot.getValue("Labels", 1)) == "Grain Boundary");
+    H5SUPPORT_REQUIRE(std::holds_alternative<std::monostate>(snapshot.getValue("Labels", 2)));
+
+    // Reading from an open object gives the same snapshot
+    AttributeSnapshot openSnapshot;
+    error = openSnapshot.read(datasetID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(openSnapshot.size() == snapshot.size());
+    H5Dclose(datasetID);
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(fileID, H5F_OBJ_ALL | H5F_OBJ_LOCAL) == 1);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAttributeUpsert()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::AttributeFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    // Track the attribute creation order so a recreated attribute can be told apart from an overwritten one
+    hid_t createPropertyList = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_attr_creation_order(createPropertyList, H5P_CRT_ORDER_TRACKED);
+    hid_t dataspaceID = H5Screate(H5S_SCALAR);
+    hid_t datasetID = H5Dcreate(fileID, "Data", H5T_NATIVE_INT32, dataspaceID, H5P_DEFAULT, createPropertyList, H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(datasetID > 0);
+    H5Sclose(dataspaceID);
+    H5Pclose(createPropertyList);
+    H5Dclose(datasetID);
+
+    auto creationOrder = [fileID](const char* attributeName) {
+      H5A_info_t info{};
+      H5Aget_info_by_name(fileID, "Data", attributeName, &info, H5P_DEFAULT);
+      return info.corder;
+    };
+
+    H5SUPPORT_REQUIRE(H5Lite::findAttribute(fileID, "Counter") == 0);
+    H5SUPPORT_REQUIRE(!H5Utilities::probeForAttribute(fileID, "Data", "Counter"));
+    H5SUPPORT_REQUIRE(!H5Utilities::probeForAttribute(fileID, "DoesNotExist", "Counter"));
+    for(int32_t i = 0; i < 10; i++)
+    {
+      herr_t error = H5Lite::writeScalarAttribute(fileID, "Data", "Counter", i);
+      H5SUPPORT_REQUIRE(error >= 0);
+      error = H5Lite::writeStringAttribute(fileID, "Data", "Timestamp", "12:00:0" + std::to_string(i));
+      H5SUPPORT_REQUIRE(error >= 0);
+      error = H5Lite::writeVectorAttribute(fileID, "Data", "Bounds", {2}, std::vector<float>{0.0f, static_cast<float>(i)});
+      H5SUPPORT_REQUIRE(error >= 0);
+    }
+    H5SUPPORT_REQUIRE(H5Utilities::probeForAttribute(fileID, "Data", "Counter"));
+    H5SUPPORT_REQUIRE(creationOrder("Counter") == 0);
+    H5SUPPORT_REQUIRE(creationOrder("Timestamp") == 1);
+    H5SUPPORT_REQUIRE(creationOrder("Bounds") == 2);
+    int32_t counter = 0;
+    herr_t error = H5Lite::readScalarAttribute(fileID, "Data", "Counter", counter);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(counter == 9);
+    std::string timestamp;
+    error = H5Lite::readStringAttribute(fileID, "Data", "Timestamp", timestamp);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(timestamp == "12:00:09");
+
+    // A different type, length or shape replaces the attribute
+    error = H5Lite::writeScalarAttribute(fileID, "Data", "Counter", 9.5);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(creationOrder("Counter") == 3);
+    error = H5Lite::writeStringAttribute(fileID, "Data", "Timestamp", "12:00:10.5");
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(creationOrder("Timestamp") == 4);
+    error = H5Lite::writeVectorAttribute(fileID, "Data", "Bounds", {3}, std::vector<float>{0.0f, 1.0f, 2.0f});
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(creationOrder("Bounds") == 5);
+    double newCounter = 0.0;
+    error = H5Lite::readScalarAttribute(fileID, "Data", "Counter", newCounter);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(newCounter == 9.5);
+    std::vector<float> bounds;
+    error = H5Lite::readVectorAttribute(fileID, "Data", "Bounds", bounds);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(bounds.size() == 3);
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(fileID, H5F_OBJ_ALL | H5F_OBJ_LOCAL) == 1);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestReplaceDataset()
+  {
+    FileCreateOptions createOptions;
+    createOptions.setPersistentFreeSpace();
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::ReplaceFile, FileAccessOptions(), createOptions);
+    H5SUPPORT_REQUIRE(fileID > 0);
+#if H5_VERSION_GE(1, 10, 1)
+    hid_t fileCreatePropertyList = H5Fget_create_plist(fileID);
+    H5F_fspace_strategy_t strategy = H5F_FSPACE_STRATEGY_NONE;
+    hbool_t persist = false;
+    hsize_t threshold = 0;
+    H5Pget_file_space_strategy(fileCreatePropertyList, &strategy, &persist, &threshold);
+    H5Pclose(fileCreatePropertyList);
+    H5SUPPORT_REQUIRE(strategy == H5F_FSPACE_STRATEGY_FSM_AGGR);
+    H5SUPPORT_REQUIRE(persist);
+#endif
+
+    auto objectAddress = [fileID](const char* datasetName) {
+      H5O_info_t objectInfo{};
+      H5Oget_info_by_name(fileID, datasetName, &objectInfo, H5P_DEFAULT);
+      return objectInfo.addr;
+    };
+
+    // Missing datasets are created, matching ones are written in place
+    std::vector<int32_t> data = {1, 2, 3, 4};
+    hsize_t dims = 4;
+    herr_t error = H5Lite::replacePointerDataset(fileID, "Contiguous", 1, &dims, data.data());
+    H5SUPPORT_REQUIRE(error >= 0);
+    haddr_t address = objectAddress("Contiguous");
+    data = {5, 6, 7, 8};
+    error = H5Lite::replacePointerDataset(fileID, "Contiguous", 1, &dims, data.data());
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(objectAddress("Contiguous") == address);
+    std::vector<int32_t> read;
+    H5Lite::readVectorDataset(fileID, "Contiguous", read);
+    H5SUPPORT_REQUIRE(read == data);
+
+    // A contiguous dataset can not change its dimensions without being recreated
+    error = H5Lite::writeScalarAttribute(fileID, "Contiguous", "Attribute", 1);
+    H5SUPPORT_REQUIRE(error >= 0);
+    data = {1, 2, 3, 4, 5, 6};
+    dims = 6;
+    error = H5Lite::replacePointerDataset(fileID, "Contiguous", 1, &dims, data.data());
+    H5SUPPORT_REQUIRE(error < 0);
+    error = H5Lite::replacePointerDataset(fileID, "Contiguous", 1, &dims, data.data(), H5Lite::ReplaceMode::Resize);
+    H5SUPPORT_REQUIRE(error < 0);
+    error = H5Lite::replacePointerDataset(fileID, "Contiguous", 1, &dims, data.data(), H5Lite::ReplaceMode::Recreate);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5Lite::readVectorDataset(fileID, "Contiguous", read);
+    H5SUPPORT_REQUIRE(read == data);
+    H5SUPPORT_REQUIRE(!H5Utilities::probeForAttribute(fileID, "Contiguous", "Attribute"));
+
+    // Recreate also changes the datatype, the other modes let HDF5 convert the values
+    std::vector<float> floats = {0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f};
+    error = H5Lite::replacePointerDataset(fileID, "Contiguous", 1, &dims, floats.data());
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5T_class_t typeClass = H5T_NO_CLASS;
+    size_t typeSize = 0;
+    std::vector<hsize_t> fileDims;
+    H5Lite::getDatasetInfo(fileID, "Contiguous", fileDims, typeClass, typeSize);
+    H5SUPPORT_REQUIRE(typeClass == H5T_INTEGER);
+    error = H5Lite::replacePointerDataset(fileID, "Contiguous", 1, &dims, floats.data(), H5Lite::ReplaceMode::Recreate);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5Lite::getDatasetInfo(fileID, "Contiguous", fileDims, typeClass, typeSize);
+    H5SUPPORT_REQUIRE(typeClass == H5T_FLOAT);
+
+    // Chunked datasets with unlimited dimensions are resized in place
+    error = H5Lite::createExtendibleDataset<int32_t>(fileID, "Chunked", {2}, 4);
+    H5SUPPORT_REQUIRE(error >= 0);
+    address = objectAddress("Chunked");
+    std::array<hsize_t, 2> chunkedDims = {5, 2};
+    data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    error = H5Lite::replacePointerDataset(fileID, "Chunked", 2, chunkedDims.data(), data.data(), H5Lite::ReplaceMode::Resize);
+    H5SUPPORT_REQUIRE(error >= 0);
+    chunkedDims = {2, 2};
+    data = {4, 3, 2, 1};
+    error = H5Lite::replacePointerDataset(fileID, "Chunked", 2, chunkedDims.data(), data.data(), H5Lite::ReplaceMode::Recreate);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(objectAddress("Chunked") == address);
+    H5Lite::readVectorDataset(fileID, "Chunked", read);
+    H5SUPPORT_REQUIRE(read == data);
+    H5Lite::getDatasetInfo(fileID, "Chunked", fileDims, typeClass, typeSize);
+    H5SUPPORT_REQUIRE(fileDims == std::vector<hsize_t>({2, 2}));
+
+    // A dimension that is not unlimited can not grow
+    chunkedDims = {2, 3};
+    data = {1, 2, 3, 4, 5, 6};
+    error = H5Lite::replacePointerDataset(fileID, "Chunked", 2, chunkedDims.data(), data.data(), H5Lite::ReplaceMode::Resize);
+    H5SUPPORT_REQUIRE(error < 0);
+    error = H5Lite::replacePointerDataset(fileID, "Chunked", 2, chunkedDims.data(), data.data(), H5Lite::ReplaceMode::Recreate);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5Lite::readVectorDataset(fileID, "Chunked", read);
+    H5SUPPORT_REQUIRE(read == data);
+    chunkedDims = {4, 3};
+    data.resize(12, 9);
+    error = H5Lite::replacePointerDataset(fileID, "Chunked", 2, chunkedDims.data(), data.data(), H5Lite::ReplaceMode::Resize);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Reused chunk dimensions shrink with fixed dimensions
+    std::array<hsize_t, 2> compressedDims = {4, 4};
+    data.resize(16);
+    std::iota(data.begin(), data.end(), 0);
+    error = H5Lite::writePointerDatasetCompressed(fileID, "Compressed", 2, compressedDims.data(), data.data(), 2, compressedDims.data(), 5);
+    H5SUPPORT_REQUIRE(error >= 0);
+    // The old dataset is parked under a temporary name that must not clobber an existing one
+    error = H5Lite::writeScalarDataset(fileID, "Compressed.replaced", 7);
+    H5SUPPORT_REQUIRE(error >= 0);
+    compressedDims = {2, 2};
+    floats = {0.5f, 1.5f, 2.5f, 3.5f};
+    error = H5Lite::replacePointerDataset(fileID, "Compressed", 2, compressedDims.data(), floats.data(), H5Lite::ReplaceMode::Recreate);
+    H5SUPPORT_REQUIRE(error >= 0);
+    std::vector<float> readFloats;
+    H5Lite::readVectorDataset(fileID, "Compressed", readFloats);
+    H5SUPPORT_REQUIRE(readFloats == floats);
+    int32_t parkedValue = 0;
+    H5Lite::readScalarDataset(fileID, "Compressed.replaced", parkedValue);
+    H5SUPPORT_REQUIRE(parkedValue == 7);
+    H5SUPPORT_REQUIRE(H5Lexists(fileID, "Compressed.replaced1", H5P_DEFAULT) == 0);
+
+    // A replacement that can not be created leaves the old dataset alone. The float scale-offset filter
+    // that is reused from the old dataset rejects integers.
+    DatasetCreateOptions scaleOffset;
+    scaleOffset.setChunked().addFilter(H5Z_FILTER_SCALEOFFSET, H5Z_FLAG_MANDATORY, {H5Z_SO_FLOAT_DSCALE, 2});
+    error = H5Lite::writePointerDataset(fileID, "ScaleOffset", 2, compressedDims.data(), floats.data(), scaleOffset);
+    H5SUPPORT_REQUIRE(error >= 0);
+    std::vector<float> before;
+    H5Lite::readVectorDataset(fileID, "ScaleOffset", before);
+    data = {1, 2, 3, 4};
+    error = H5Lite::replacePointerDataset(fileID, "ScaleOffset", 2, compressedDims.data(), data.data(), H5Lite::ReplaceMode::Recreate);
+    H5SUPPORT_REQUIRE(error < 0);
+    readFloats.clear();
+    error = H5Lite::readVectorDataset(fileID, "ScaleOffset", readFloats);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(readFloats.size() == 4 && readFloats == before);
+
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(fileID, H5F_OBJ_ALL | H5F_OBJ_LOCAL) == 1);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDatasetCreateOptions()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::DatasetOptionsFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    H5SUPPORT_REQUIRE(DatasetCreateOptions().isDefault());
+
+    auto getCreatePropertyList = [fileID](const char* datasetName) {
+      hid_t datasetID = H5Dopen(fileID, datasetName, H5P_DEFAULT);
+      hid_t createPropertyList = H5Dget_create_plist(datasetID);
+      H5Dclose(datasetID);
+      return createPropertyList;
+    };
+
+    std::vector<int32_t> data(64 * 64);
+    for(size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<int32_t>(i);
+    }
+    std::vector<hsize_t> dims = {64, 64};
+
+    // Chunked with filters
+    DatasetCreateOptions options;
+    options.setChunked({16, 16}).setShuffle().setDeflate(5);
+    H5SUPPORT_REQUIRE(!options.isDefault());
+    herr_t error = H5Lite::writeVectorDataset(fileID, "Chunked", dims, data, options);
+    H5SUPPORT_REQUIRE(error >= 0);
+    hid_t createPropertyList = getCreatePropertyList("Chunked");
+    H5SUPPORT_REQUIRE(H5Pget_layout(createPropertyList) == H5D_CHUNKED);
+    std::array<hsize_t, 2> chunkDims = {0, 0};
+    H5Pget_chunk(createPropertyList, 2, chunkDims.data());
+    H5SUPPORT_REQUIRE(chunkDims[0] == 16 && chunkDims[1] == 16);
+    H5SUPPORT_REQUIRE(H5Pget_nfilters(createPropertyList) == 2);
+    H5Pclose(createPropertyList);
+    std::vector<int32_t> read;
+    error = H5Lite::readVectorDataset(fileID, "Chunked", read);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(read == data);
+
+    // Filters without chunk dimensions get them picked for the dataset
+    error = H5Lite::writeVectorDataset(fileID, "Guessed", dims, data, DatasetCreateOptions().setDeflate(1));
+    H5SUPPORT_REQUIRE(error >= 0);
+    createPropertyList = getCreatePropertyList("Guessed");
+    H5SUPPORT_REQUIRE(H5Pget_layout(createPropertyList) == H5D_CHUNKED);
+    H5Pclose(createPropertyList);
+
+    // Late allocation, no fill values and a fill value for the parts never written
+    options = DatasetCreateOptions();
+    options.setAllocTime(H5D_ALLOC_TIME_LATE).setFillTime(H5D_FILL_TIME_NEVER).setFillValue(int32_t(-1));
+    error = H5Lite::writePointerDataset(fileID, "Late", 2, dims.data(), data.data(), options);
+    H5SUPPORT_REQUIRE(error >= 0);
+    createPropertyList = getCreatePropertyList("Late");
+    H5D_alloc_time_t allocTime = H5D_ALLOC_TIME_DEFAULT;
+    H5D_fill_time_t fillTime = H5D_FILL_TIME_ALLOC;
+    int32_t fillValue = 0;
+    H5Pget_alloc_time(createPropertyList, &allocTime);
+    H5Pget_fill_time(createPropertyList, &fillTime);
+    H5Pget_fill_value(createPropertyList, H5T_NATIVE_INT32, &fillValue);
+    H5Pclose(createPropertyList);
+    H5SUPPORT_REQUIRE(allocTime == H5D_ALLOC_TIME_LATE);
+    H5SUPPORT_REQUIRE(fillTime == H5D_FILL_TIME_NEVER);
+    H5SUPPORT_REQUIRE(fillValue == -1);
+
+    // Compact scalars and arrays
+    error = H5Lite::writeScalarDataset(fileID, "Scalar", 3.5, DatasetCreateOptions().setCompact());
+    H5SUPPORT_REQUIRE(error >= 0);
+    createPropertyList = getCreatePropertyList("Scalar");
+    H5SUPPORT_REQUIRE(H5Pget_layout(createPropertyList) == H5D_COMPACT);
+    H5Pclose(createPropertyList);
+    double scalar = 0.0;
+    error = H5Lite::readScalarDataset(fileID, "Scalar", scalar);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(scalar == 3.5);
+    std::array<float, 3> origin = {1.0f, 2.0f, 3.0f};
+    error = H5Lite::writeArrayDataset(fileID, "Origin", {3}, origin, DatasetCreateOptions().setCompact());
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Raw data in an external file
+    error = H5Lite::writeVectorDataset(fileID, "External", dims, data, DatasetCreateOptions().setContiguous().addExternalFile(UnitTest::H5LiteTest::ExternalRawFile));
+    H5SUPPORT_REQUIRE(error >= 0);
+    createPropertyList = getCreatePropertyList("External");
+    H5SUPPORT_REQUIRE(H5Pget_external_count(createPropertyList) == 1);
+    H5Pclose(createPropertyList);
+    read.clear();
+    error = H5Lite::readVectorDataset(fileID, "External", read);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(read == data);
+
+    // Settings HDF5 rejects fail the write
+    error = H5Lite::writeVectorDataset(fileID, "BadChunks", dims, data, DatasetCreateOptions().setChunked({16}));
+    H5SUPPORT_REQUIRE(error < 0);
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(fileID, H5F_OBJ_ALL | H5F_OBJ_LOCAL) == 1);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCompactLayout()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::CompactFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    const size_t defaultThreshold = H5Lite::getCompactLayoutThreshold();
+    H5SUPPORT_REQUIRE(defaultThreshold > 0);
+
+    auto getLayout = [fileID](const char* datasetName) {
+      hid_t datasetID = H5Dopen(fileID, datasetName, H5P_DEFAULT);
+      hid_t createPropertyList = H5Dget_create_plist(datasetID);
+      H5D_layout_t layout = H5Pget_layout(createPropertyList);
+      H5Pclose(createPropertyList);
+      H5Dclose(datasetID);
+      return layout;
+    };
+
+    // Scalars, short vectors and short strings live in the object header
+    herr_t error = H5Lite::writeScalarDataset(fileID, "Scalar", 42);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(getLayout("Scalar") == H5D_COMPACT);
+    int32_t scalar = 0;
+    error = H5Lite::readScalarDataset(fileID, "Scalar", scalar);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(scalar == 42);
+
+    std::vector<float> spacing = {0.5f, 0.25f, 1.0f};
+    error = H5Lite::writeVectorDataset(fileID, "Spacing", {spacing.size()}, spacing);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(getLayout("Spacing") == H5D_COMPACT);
+    std::vector<float> readSpacing;
+    error = H5Lite::readVectorDataset(fileID, "Spacing", readSpacing);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(readSpacing == spacing);
+
+    error = H5Lite::writeStringDataset(fileID, "Name", std::string("Compact"));
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(getLayout("Name") == H5D_COMPACT);
+
+    // Larger data stays contiguous
+    std::vector<int32_t> data(defaultThreshold);
+    std::iota(data.begin(), data.end(), 0);
+    error = H5Lite::writeVectorDataset(fileID, "Large", {data.size()}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(getLayout("Large") == H5D_CONTIGUOUS);
+
+    // Explicit options win over the threshold
+    error = H5Lite::writeScalarDataset(fileID, "Contiguous", 42, DatasetCreateOptions().setContiguous());
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(getLayout("Contiguous") == H5D_CONTIGUOUS);
+    error = H5Lite::writeScalarDataset(fileID, "Late", 42, DatasetCreateOptions().setAllocTime(H5D_ALLOC_TIME_LATE));
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(getLayout("Late") == H5D_CONTIGUOUS);
+    error = H5Lite::writeScalarDataset(fileID, "Filled", 42, DatasetCreateOptions().setFillValue(int32_t(-1)));
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(getLayout("Filled") == H5D_COMPACT);
+
+    // A compact dataset that outgrows the threshold is recreated contiguous
+    error = H5Lite::replacePointerDataset(fileID, "Spacing", 1, std::array<hsize_t, 1>{data.size()}.data(), data.data(), H5Lite::ReplaceMode::Recreate);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(getLayout("Spacing") == H5D_CONTIGUOUS);
+
+    // A threshold of 0 turns it off
+    H5Lite::setCompactLayoutThreshold(0);
+    error = H5Lite::writeScalarDataset(fileID, "Off", 42);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(getLayout("Off") == H5D_CONTIGUOUS);
+    H5Lite::setCompactLayoutThreshold(std::numeric_limits<size_t>::max());
+    H5SUPPORT_REQUIRE(H5Lite::getCompactLayoutThreshold() == H5Lite::k_MaxCompactLayoutSize);
+    H5Lite::setCompactLayoutThreshold(defaultThreshold);
+
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(fileID, H5F_OBJ_ALL | H5F_OBJ_LOCAL) == 1);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDatasetTemplate()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::TemplateFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+
+    // Many compressed datasets of the same shape
+    DatasetTemplate<float> grainTemplate({256, 3}, DatasetCreateOptions().setShuffle().setDeflate(5));
+    H5SUPPORT_REQUIRE(grainTemplate.isValid());
+    H5SUPPORT_REQUIRE(grainTemplate.getNumElements() == 256 * 3);
+    herr_t error = grainTemplate.setChunkCache(521, 1024 * 1024, 0.75);
+    H5SUPPORT_REQUIRE(error >= 0);
+    std::vector<float> values(grainTemplate.getNumElements());
+    for(int32_t grain = 0; grain < 100; grain++)
+    {
+      std::iota(values.begin(), values.end(), static_cast<float>(grain));
+      error = grainTemplate.create(fileID, "Grain_" + std::to_string(grain), values);
+      H5SUPPORT_REQUIRE(error >= 0);
+    }
+    std::vector<float> read;
+    error = H5Lite::readVectorDataset(fileID, "Grain_42", read);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(read.size() == values.size());
+    H5SUPPORT_REQUIRE(read[0] == 42.0f && read.back() == 42.0f + static_cast<float>(values.size() - 1));
+    hid_t datasetID = H5Dopen(fileID, "Grain_42", H5P_DEFAULT);
+    hid_t createPropertyList = H5Dget_create_plist(datasetID);
+    H5SUPPORT_REQUIRE(H5Pget_layout(createPropertyList) == H5D_CHUNKED);
+    H5SUPPORT_REQUIRE(H5Pget_nfilters(createPropertyList) == 2);
+    H5Pclose(createPropertyList);
+    H5Dclose(datasetID);
+
+    // Small default datasets are compact like the ones H5Lite writes
+    DatasetTemplate<int32_t> originTemplate({3});
+    std::array<int32_t, 3> origin = {1, 2, 3};
+    error = originTemplate.create(fileID, "Origin", origin.data());
+    H5SUPPORT_REQUIRE(error >= 0);
+    datasetID = H5Dopen(fileID, "Origin", H5P_DEFAULT);
+    createPropertyList = H5Dget_create_plist(datasetID);
+    H5SUPPORT_REQUIRE(H5Pget_layout(createPropertyList) == H5D_COMPACT);
+    H5Pclose(createPropertyList);
+    H5Dclose(datasetID);
+
+    // Data of the wrong size, existing names and bad options fail
+    error = grainTemplate.create(fileID, "Short", std::vector<float>(10));
+    H5SUPPORT_REQUIRE(error < 0);
+    error = grainTemplate.create(fileID, "Grain_0", values);
+    H5SUPPORT_REQUIRE(error < 0);
+    error = originTemplate.create(fileID, "Null", nullptr);
+    H5SUPPORT_REQUIRE(error < 0);
+    DatasetTemplate<int32_t> badTemplate({16, 16}, DatasetCreateOptions().setChunked({16}));
+    error = badTemplate.create(fileID, "BadChunks", std::vector<int32_t>(256));
+    H5SUPPORT_REQUIRE(error < 0);
+
+    H5SUPPORT_REQUIRE(H5Fget_obj_count(fileID, H5F_OBJ_ALL | H5F_OBJ_LOCAL) == 1);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+#ifdef H5Support_USE_MUTEX
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestConcurrentAccess()
+  {
+    constexpr size_t k_NumThreads = 4;
+    constexpr size_t k_NumIterations = 50;
+
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::ConcurrentFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    std::vector<int32_t> data(1000);
+    std::iota(data.begin(), data.end(), 0);
+    herr_t error = H5Lite::writeVectorDataset(fileID, "Data", {data.size()}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // The caches are invalidated from some threads while the others read and create groups through them
+    error = H5ObjectCache::enable(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5GroupPathCache::enable(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    resetLockStatistics();
+    std::vector<size_t> failures(k_NumThreads, 0);
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < k_NumThreads; t++)
+    {
+      threads.emplace_back([&, t]() {
+        for(size_t i = 0; i < k_NumIterations; i++)
+        {
+          if(t % 2 == 1 && (H5ObjectCache::invalidate(fileID, "Data") < 0 || H5GroupPathCache::invalidate(fileID, "/") < 0))
+          {
+            failures[t]++;
+          }
+          if(t % 2 == 0 && H5Utilities::createGroupsFromPath("Group" + std::to_string(t) + "/Child", fileID) < 0)
+          {
+            failures[t]++;
+          }
+          std::vector<int32_t> readBack;
+          std::string name = "Thread" + std::to_string(t) + "_" + std::to_string(i);
+          if(H5Lite::readVectorDataset(fileID, "Data", readBack) < 0 || readBack != data || H5Lite::writeScalarAttribute(fileID, "Data", name, static_cast<int32_t>(i)) < 0)
+          {
+            failures[t]++;
+          }
+        }
+      });
+    }
+    for(auto& thread : threads)
+    {
+      thread.join();
+    }
+    for(size_t count : failures)
+    {
+      H5SUPPORT_REQUIRE(count == 0);
+    }
+
+    LockStatistics stats = getLockStatistics();
+    H5SUPPORT_REQUIRE(stats.acquisitions >= k_NumThreads * k_NumIterations * 2);
+    H5SUPPORT_REQUIRE(stats.contentions <= stats.acquisitions);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+#endif
+
+#ifdef H5Support_HAVE_PARALLEL_DEFLATE
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestParallelDeflateWrite()
+  {
+    // The dimensions are not multiples of the chunk dimensions so the edge chunks get exercised
+    const std::vector<hsize_t> dims = {37, 19, 11};
+    const std::vector<hsize_t> cDims = {8, 8, 4};
+    std::vector<float> data(37 * 19 * 11);
+    for(size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<float>(i % 97) * 0.5f;
+    }
+
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::ParallelDeflateFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    herr_t error = H5Lite::writeVectorDatasetCompressed(fileID, "Serial", dims, data, cDims, 6);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorDatasetCompressedParallel(fileID, "Parallel", dims, data, cDims, 6, 4);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorDatasetCompressedParallel(fileID, "SingleThread", {5}, std::vector<int32_t>({1, 2, 3, 4, 5}), {2}, 1, 1);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorDatasetCompressedParallel(fileID, "BadChunkRank", dims, data, {8, 8}, 6);
+    H5SUPPORT_REQUIRE(error < 0);
+
+    std::vector<float> readBack;
+    error = H5Lite::readVectorDataset(fileID, "Parallel", readBack);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(readBack == data);
+    std::vector<int32_t> ints;
+    error = H5Lite::readVectorDataset(fileID, "SingleThread", ints);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(ints == std::vector<int32_t>({1, 2, 3, 4, 5}));
+
+    // Every stored chunk must be byte for byte what the deflate filter produced
+    hid_t serialID = H5Dopen(fileID, "Serial", H5P_DEFAULT);
+    hid_t parallelID = H5Dopen(fileID, "Parallel", H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(serialID > 0);
+    H5SUPPORT_REQUIRE(parallelID > 0);
+    hid_t spaceID = H5Dget_space(serialID);
+    hsize_t numChunks = 0;
+    hsize_t parallelChunks = 0;
+    H5SUPPORT_REQUIRE(H5Dget_num_chunks(serialID, spaceID, &numChunks) >= 0);
+    H5SUPPORT_REQUIRE(H5Dget_num_chunks(parallelID, spaceID, &parallelChunks) >= 0);
+    H5SUPPORT_REQUIRE(numChunks == 5 * 3 * 3);
+    H5SUPPORT_REQUIRE(parallelChunks == numChunks);
+    for(hsize_t i = 0; i < numChunks; i++)
+    {
+      std::array<hsize_t, 3> offset = {0, 0, 0};
+      uint32_t filterMask = 0;
+      haddr_t address = 0;
+      hsize_t serialSize = 0;
+      hsize_t parallelSize = 0;
+      H5SUPPORT_REQUIRE(H5Dget_chunk_info(serialID, spaceID, i, offset.data(), &filterMask, &address, &serialSize) >= 0);
+      H5SUPPORT_REQUIRE(H5Dget_chunk_storage_size(parallelID, offset.data(), &parallelSize) >= 0);
+      H5SUPPORT_REQUIRE(serialSize == parallelSize);
+      std::vector<uint8_t> serialChunk(serialSize);
+      std::vector<uint8_t> parallelChunk(parallelSize);
+      H5SUPPORT_REQUIRE(H5Dread_chunk(serialID, H5P_DEFAULT, offset.data(), &filterMask, serialChunk.data()) >= 0);
+      H5SUPPORT_REQUIRE(H5Dread_chunk(parallelID, H5P_DEFAULT, offset.data(), &filterMask, parallelChunk.data()) >= 0);
+      H5SUPPORT_REQUIRE(filterMask == 0);
+      H5SUPPORT_REQUIRE(serialChunk == parallelChunk);
+    }
+    H5Sclose(spaceID);
+    H5Dclose(serialID);
+    H5Dclose(parallelID);
+
+    // Chunks of noise do not shrink, so they are stored uncompressed with the deflate filter flagged as skipped
+    std::vector<uint32_t> noise(4096);
+    uint32_t seed = 12345;
+    for(auto& value : noise)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      value = seed;
+    }
+    error = H5Lite::writeVectorDatasetCompressed(fileID, "SerialNoise", {4096}, noise, {1024}, 9);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorDatasetCompressedParallel(fileID, "ParallelNoise", {4096}, noise, {1024}, 9, 2);
+    H5SUPPORT_REQUIRE(error >= 0);
+    std::vector<uint32_t> noiseBack;
+    error = H5Lite::readVectorDataset(fileID, "ParallelNoise", noiseBack);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(noiseBack == noise);
+    parallelID = H5Dopen(fileID, "ParallelNoise", H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(parallelID > 0);
+    for(hsize_t i = 0; i < 4; i++)
+    {
+      std::array<hsize_t, 1> offset = {i * 1024};
+      hsize_t parallelSize = 0;
+      H5SUPPORT_REQUIRE(H5Dget_chunk_storage_size(parallelID, offset.data(), &parallelSize) >= 0);
+      H5SUPPORT_REQUIRE(parallelSize == 1024 * sizeof(uint32_t));
+      uint32_t parallelMask = 0;
+      std::vector<uint32_t> parallelChunk(1024);
+      H5SUPPORT_REQUIRE(H5Dread_chunk(parallelID, H5P_DEFAULT, offset.data(), &parallelMask, parallelChunk.data()) >= 0);
+      H5SUPPORT_REQUIRE(parallelMask == 0x1);
+      H5SUPPORT_REQUIRE(std::equal(parallelChunk.begin(), parallelChunk.end(), noise.begin() + static_cast<std::ptrdiff_t>(offset[0])));
+    }
+    H5Dclose(parallelID);
+    error = H5Lite::readVectorDataset(fileID, "SerialNoise", noiseBack);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(noiseBack == noise);
+    noiseBack.clear();
+    error = H5Lite::readVectorDatasetParallel(fileID, "ParallelNoise", noiseBack, 2);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(noiseBack == noise);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestParallelDeflateRead()
+  {
+    std::vector<int32_t> data(37 * 19 * 11);
+    std::iota(data.begin(), data.end(), -500);
+
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5LiteTest::ParallelDeflateFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    // Edge chunks, chunks that are whole slabs of the array, uncompressed and a type conversion
+    herr_t error = H5Lite::writeVectorDatasetCompressed(fileID, "Edges", {37, 19, 11}, data, {8, 8, 4}, 6);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorDatasetCompressed(fileID, "Slabs", {37, 19, 11}, data, {5, 19, 11}, 1);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorDataset(fileID, "Contiguous", {37, 19, 11}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    for(const auto& name : {"Edges", "Slabs", "Contiguous"})
+    {
+      std::vector<int32_t> readBack;
+      error = H5Lite::readVectorDatasetParallel(fileID, name, readBack, 3);
+      H5SUPPORT_REQUIRE(error >= 0);
+      H5SUPPORT_REQUIRE(readBack == data);
+    }
+
+    std::vector<int64_t> converted(data.size(), 0);
+    error = H5Lite::readPointerDatasetParallel(fileID, "Edges", converted.data());
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(converted.front() == -500);
+    H5SUPPORT_REQUIRE(converted.back() == static_cast<int64_t>(data.back()));
+
+    std::vector<int32_t> missing;
+    error = H5Lite::readVectorDatasetParallel(fileID, "DoesNotExist", missing);
+    H5SUPPORT_REQUIRE(error < 0);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+#endif
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -990,6 +2335,27 @@ public:
   {
     H5SUPPORT_REGISTER_TEST(TestVLengStringReadWrite())
     H5SUPPORT_REGISTER_TEST(TestTypeDetection())
+    H5SUPPORT_REGISTER_TEST(TestHyperslab())
+    H5SUPPORT_REGISTER_TEST(TestAppendDataset())
+    H5SUPPORT_REGISTER_TEST(TestObjectCache())
+    H5SUPPORT_REGISTER_TEST(TestAsyncIO())
+    H5SUPPORT_REGISTER_TEST(TestMapDataset())
+    H5SUPPORT_REGISTER_TEST(TestHandles())
+    H5SUPPORT_REGISTER_TEST(TestPaths())
+    H5SUPPORT_REGISTER_TEST(TestAttributeBatch())
+    H5SUPPORT_REGISTER_TEST(TestAttributeSnapshot())
+    H5SUPPORT_REGISTER_TEST(TestAttributeUpsert())
+    H5SUPPORT_REGISTER_TEST(TestReplaceDataset())
+    H5SUPPORT_REGISTER_TEST(TestDatasetCreateOptions())
+    H5SUPPORT_REGISTER_TEST(TestCompactLayout())
+    H5SUPPORT_REGISTER_TEST(TestDatasetTemplate())
+#ifdef H5Support_USE_MUTEX
+    H5SUPPORT_REGISTER_TEST(TestConcurrentAccess())
+#endif
+#ifdef H5Support_HAVE_PARALLEL_DEFLATE
+    H5SUPPORT_REGISTER_TEST(TestParallelDeflateWrite())
+    H5SUPPORT_REGISTER_TEST(TestParallelDeflateRead())
+#endif
     H5SUPPORT_REGISTER_TEST(Test())
     H5SUPPORT_REGISTER_TEST(RemoveTestFiles())
   }
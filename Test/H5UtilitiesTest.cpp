@@ -32,15 +32,22 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
 #include <iostream>
 #include <list>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "H5Support/H5FileIndex.h"
+#include "H5Support/H5GroupPathCache.h"
 #include "H5Support/H5Lite.h"
+#include "H5Support/H5ScopedErrorHandler.h"
 #include "H5Support/H5Utilities.h"
 
 #include "H5SupportTestHelper.h"
@@ -79,6 +86,18 @@ public:
 #if REMOVE_TEST_FILES
     std::remove(UnitTest::H5UtilTest::FileName.c_str());
     std::remove(UnitTest::H5UtilTest::GroupTest.c_str());
+    std::remove(UnitTest::H5UtilTest::AccessOptionsFile.c_str());
+    std::remove(UnitTest::H5UtilTest::CacheImageFile.c_str());
+    std::remove(UnitTest::H5UtilTest::PagedFile.c_str());
+    std::remove(UnitTest::H5UtilTest::FileIndexFile.c_str());
+    for(int32_t i = 0; i < 4; i++)
+    {
+      std::array<char, 1024> familyMember = {0};
+      snprintf(familyMember.data(), familyMember.size(), UnitTest::H5UtilTest::FamilyFile.c_str(), i);
+      std::remove(familyMember.data());
+    }
+    std::remove((UnitTest::H5UtilTest::SplitFile + "-m.h5").c_str());
+    std::remove((UnitTest::H5UtilTest::SplitFile + "-r.h5").c_str());
 #endif
   }
 
@@ -220,6 +239,569 @@ public:
     H5SUPPORT_REQUIRE(error == 0);
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFileAccessOptions()
+  {
+    std::vector<int32_t> data(64 * 1024);
+    for(size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<int32_t>(i);
+    }
+
+    // The core driver writes the in memory image back to disk on close
+    FileAccessOptions options;
+    options.setCoreDriver(1024 * 1024, true).setAlignment(1024, 4096);
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5UtilTest::AccessOptionsFile, options);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    herr_t error = H5Lite::writeVectorDataset(fileID, "Data", {data.size()}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    hid_t accessPropertyList = H5Fget_access_plist(fileID);
+    H5SUPPORT_REQUIRE(H5Pget_driver(accessPropertyList) == H5FD_CORE);
+    H5Pclose(accessPropertyList);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    options = FileAccessOptions();
+    options.setStdioDriver().setMetadataCacheSize(8 * 1024 * 1024, 32 * 1024 * 1024).setSieveBufferSize(4 * 1024 * 1024);
+    fileID = H5Utilities::openFile(UnitTest::H5UtilTest::AccessOptionsFile, true, options);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    accessPropertyList = H5Fget_access_plist(fileID);
+    H5SUPPORT_REQUIRE(H5Pget_driver(accessPropertyList) == H5FD_STDIO);
+    size_t sieveSize = 0;
+    H5Pget_sieve_buf_size(accessPropertyList, &sieveSize);
+    H5SUPPORT_REQUIRE(sieveSize == 4 * 1024 * 1024);
+    H5Pclose(accessPropertyList);
+    H5AC_cache_config_t config;
+    config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    error = H5Fget_mdc_config(fileID, &config);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(config.max_size == 32 * 1024 * 1024);
+    std::vector<int32_t> readData;
+    error = H5Lite::readVectorDataset(fileID, "Data", readData);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(readData == data);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Files opened for writing get the library version bounds
+    fileID = H5Utilities::openFile(UnitTest::H5UtilTest::AccessOptionsFile, false);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    accessPropertyList = H5Fget_access_plist(fileID);
+    H5F_libver_t low = H5F_LIBVER_EARLIEST;
+    H5F_libver_t high = H5F_LIBVER_EARLIEST;
+    H5Pget_libver_bounds(accessPropertyList, &low, &high);
+    H5SUPPORT_REQUIRE(low == HDF5_VERSION_LIB_LOWER_BOUNDS);
+    H5SUPPORT_REQUIRE(high == HDF5_VERSION_LIB_UPPER_BOUNDS);
+    H5Pclose(accessPropertyList);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Family members are capped at the member size
+    options = FileAccessOptions();
+    options.setFamilyDriver(128 * 1024);
+    fileID = H5Utilities::createFile(UnitTest::H5UtilTest::FamilyFile, options);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    error = H5Lite::writeVectorDataset(fileID, "Data", {data.size()}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    fileID = H5Utilities::openFile(UnitTest::H5UtilTest::FamilyFile, true, options);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    error = H5Lite::readVectorDataset(fileID, "Data", readData);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(readData == data);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    options = FileAccessOptions();
+    options.setSplitDriver();
+    fileID = H5Utilities::createFile(UnitTest::H5UtilTest::SplitFile, options);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    error = H5Lite::writeVectorDataset(fileID, "Data", {data.size()}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    fileID = H5Utilities::openFile(UnitTest::H5UtilTest::SplitFile, true, options);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    error = H5Lite::readVectorDataset(fileID, "Data", readData);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(readData == data);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFileImage()
+  {
+    std::vector<float> data(10000);
+    for(size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<float>(i) * 0.5f;
+    }
+
+    hid_t fileID = H5Utilities::createInMemoryFile();
+    H5SUPPORT_REQUIRE(fileID > 0);
+    herr_t error = H5Lite::writeVectorDataset(fileID, "Data", {100, 100}, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeStringAttribute(fileID, "Data", "Units", "mm");
+    H5SUPPORT_REQUIRE(error >= 0);
+    // Two in-memory files can be open at the same time
+    hid_t otherFileID = H5Utilities::createInMemoryFile();
+    H5SUPPORT_REQUIRE(otherFileID > 0);
+    error = H5Utilities::closeFile(otherFileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    std::vector<uint8_t> image;
+    error = H5Utilities::getFileImage(fileID, image);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(image.size() > data.size() * sizeof(float));
+    const std::array<uint8_t, 8> signature = {0x89, 'H', 'D', 'F', '\r', '\n', 0x1a, '\n'};
+    H5SUPPORT_REQUIRE(std::equal(signature.begin(), signature.end(), image.begin()));
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    fileID = H5Utilities::openFileImage(image);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    std::vector<float> readData;
+    error = H5Lite::readVectorDataset(fileID, "Data", readData);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(readData == data);
+    std::string units;
+    error = H5Lite::readStringAttribute(fileID, "Data", "Units", units);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(units == "mm");
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Writable images keep their changes in memory
+    fileID = H5Utilities::openFileImage(image, false);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    error = H5Lite::writeScalarDataset(fileID, "Scalar", 42);
+    H5SUPPORT_REQUIRE(error >= 0);
+    std::vector<uint8_t> changedImage;
+    error = H5Utilities::getFileImage(fileID, changedImage);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    fileID = H5Utilities::openFileImage(changedImage);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    int32_t scalar = 0;
+    error = H5Lite::readScalarDataset(fileID, "Scalar", scalar);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(scalar == 42);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    std::vector<uint8_t> garbage(1024, 0);
+    fileID = H5Utilities::openFileImage(garbage);
+    H5SUPPORT_REQUIRE(fileID < 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMetadataCacheImage()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5UtilTest::CacheImageFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    for(int32_t i = 0; i < 50; i++)
+    {
+      hid_t groupID = H5Utilities::createGroup(fileID, "Group_" + std::to_string(i));
+      H5SUPPORT_REQUIRE(groupID > 0);
+      herr_t error = H5Lite::writeScalarAttribute(fileID, "Group_" + std::to_string(i), "Index", i);
+      H5SUPPORT_REQUIRE(error >= 0);
+      H5Gclose(groupID);
+    }
+    herr_t error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    fileID = H5Utilities::openFile(UnitTest::H5UtilTest::CacheImageFile, true);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    H5SUPPORT_REQUIRE(H5Utilities::getMetadataCacheImageSize(fileID) == 0);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    error = H5Utilities::writeMetadataCacheImage(UnitTest::H5UtilTest::CacheImageFile);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+#if H5_VERSION_GE(1, 10, 1)
+    // Read only opens load the image and leave it in the file
+    for(int32_t pass = 0; pass < 2; pass++)
+    {
+      fileID = H5Utilities::openFile(UnitTest::H5UtilTest::CacheImageFile, true);
+      H5SUPPORT_REQUIRE(fileID > 0);
+      H5SUPPORT_REQUIRE(H5Utilities::getMetadataCacheImageSize(fileID) > 0);
+      std::list<std::string> names;
+      error = H5Utilities::getGroupObjects(fileID, H5Utilities::CustomHDFDataTypes::Group, names);
+      H5SUPPORT_REQUIRE(error >= 0);
+      H5SUPPORT_REQUIRE(names.size() == 50);
+      int32_t index = -1;
+      error = H5Lite::readScalarAttribute(fileID, "Group_49", "Index", index);
+      H5SUPPORT_REQUIRE(error >= 0);
+      H5SUPPORT_REQUIRE(index == 49);
+      error = H5Utilities::closeFile(fileID);
+      H5SUPPORT_REQUIRE(error >= 0);
+    }
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestPagedFileSpace()
+  {
+#if H5_VERSION_GE(1, 10, 1)
+    FileCreateOptions createOptions;
+    createOptions.setPagedFileSpace(4096);
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5UtilTest::PagedFile, FileAccessOptions(), createOptions);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    for(int32_t i = 0; i < 20; i++)
+    {
+      std::string groupName = "Group_" + std::to_string(i);
+      hid_t groupID = H5Utilities::createGroup(fileID, groupName);
+      H5SUPPORT_REQUIRE(groupID > 0);
+      H5Gclose(groupID);
+      herr_t error = H5Lite::writeScalarAttribute(fileID, groupName, "Index", i);
+      H5SUPPORT_REQUIRE(error >= 0);
+    }
+    hid_t createPropertyList = H5Fget_create_plist(fileID);
+    H5F_fspace_strategy_t strategy = H5F_FSPACE_STRATEGY_NTYPES;
+    hbool_t persist = false;
+    hsize_t threshold = 0;
+    hsize_t pageSize = 0;
+    H5Pget_file_space_strategy(createPropertyList, &strategy, &persist, &threshold);
+    H5Pget_file_space_page_size(createPropertyList, &pageSize);
+    H5Pclose(createPropertyList);
+    H5SUPPORT_REQUIRE(strategy == H5F_FSPACE_STRATEGY_PAGE);
+    H5SUPPORT_REQUIRE(pageSize == 4096);
+    herr_t error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Metadata reads go through the page buffer
+    FileAccessOptions options;
+    options.setPageBufferSize(64 * 1024);
+    fileID = H5Utilities::openFile(UnitTest::H5UtilTest::PagedFile, true, options);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    for(int32_t i = 0; i < 20; i++)
+    {
+      int32_t index = -1;
+      error = H5Lite::readScalarAttribute(fileID, "Group_" + std::to_string(i), "Index", index);
+      H5SUPPORT_REQUIRE(error >= 0);
+      H5SUPPORT_REQUIRE(index == i);
+    }
+    std::array<unsigned, 2> accesses = {0, 0};
+    std::array<unsigned, 2> hits = {0, 0};
+    std::array<unsigned, 2> misses = {0, 0};
+    std::array<unsigned, 2> evictions = {0, 0};
+    std::array<unsigned, 2> bypasses = {0, 0};
+    error = H5Fget_page_buffering_stats(fileID, accesses.data(), hits.data(), misses.data(), evictions.data(), bypasses.data());
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(accesses[0] > 0);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFileIndex()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5UtilTest::FileIndexFile);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    hid_t groupID = H5Utilities::createGroup(fileID, "Data");
+    H5SUPPORT_REQUIRE(groupID > 0);
+    std::vector<float> data(20 * 30, 1.0f);
+    herr_t error = H5Lite::writeVectorDatasetCompressed(groupID, "Compressed", {20, 30}, data, {10, 10}, 1);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeStringDataset(groupID, "Name", "Sample");
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorAttribute(groupID, "Compressed", "Origin", {3}, std::vector<double>{0.0, 1.0, 2.0});
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeStringAttribute(fileID, "Data", "Units", "mm");
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5Gclose(groupID);
+
+    H5FileIndex index;
+    error = index.build(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(index.size() == 4);
+    H5SUPPORT_REQUIRE(index.isGroup("/"));
+    H5SUPPORT_REQUIRE(index.isGroup("/Data"));
+    H5SUPPORT_REQUIRE(index.datasetExists("Data/Compressed"));
+    H5SUPPORT_REQUIRE(!index.datasetExists("Data"));
+    H5SUPPORT_REQUIRE(!index.objectExists("Data/DoesNotExist"));
+    int32_t objectType = -1;
+    H5SUPPORT_REQUIRE(index.getObjectType("Data/Name/", objectType) >= 0);
+    H5SUPPORT_REQUIRE(objectType == H5O_TYPE_DATASET);
+
+    // The index answers like the functions that read the file
+    std::vector<hsize_t> dims;
+    std::vector<hsize_t> fileDims;
+    H5T_class_t typeClass = H5T_NO_CLASS;
+    H5T_class_t fileTypeClass = H5T_NO_CLASS;
+    size_t typeSize = 0;
+    size_t fileTypeSize = 0;
+    H5SUPPORT_REQUIRE(index.getDatasetInfo("Data/Name", dims, typeClass, typeSize) >= 0);
+    H5SUPPORT_REQUIRE(H5Lite::getDatasetInfo(fileID, "Data/Name", fileDims, fileTypeClass, fileTypeSize) >= 0);
+    H5SUPPORT_REQUIRE(dims == fileDims && typeClass == fileTypeClass && typeSize == fileTypeSize);
+    const H5FileIndex::Node* node = index.find("/Data/Compressed");
+    H5SUPPORT_REQUIRE(node != nullptr);
+    H5SUPPORT_REQUIRE(node->dims == std::vector<hsize_t>({20, 30}));
+    H5SUPPORT_REQUIRE(node->typeClass == H5T_FLOAT && node->typeSize == 4);
+    H5SUPPORT_REQUIRE(node->layout == H5D_CHUNKED);
+    H5SUPPORT_REQUIRE(node->filters == std::vector<H5Z_filter_t>({H5Z_FILTER_DEFLATE}));
+    H5SUPPORT_REQUIRE(node->attributeNames == std::vector<std::string>({"Origin"}));
+    H5SUPPORT_REQUIRE(index.getAttributeInfo("Data/Compressed", "Origin", dims, typeClass, typeSize) >= 0);
+    H5SUPPORT_REQUIRE(dims == std::vector<hsize_t>({3}) && typeClass == H5T_FLOAT && typeSize == 8);
+    hid_t typeID = -1;
+    H5SUPPORT_REQUIRE(index.getAttributeInfo("Data", "Units", dims, typeClass, typeSize) >= 0);
+    H5SUPPORT_REQUIRE(H5Lite::getAttributeInfo(fileID, "Data", "Units", fileDims, fileTypeClass, fileTypeSize, typeID) >= 0);
+    H5Tclose(typeID);
+    H5SUPPORT_REQUIRE(dims == fileDims && typeClass == fileTypeClass && typeSize == fileTypeSize);
+    H5SUPPORT_REQUIRE(index.find("Data")->children == std::vector<std::string>({"Compressed", "Name"}));
+
+    // Refreshing a subtree picks up additions and removals
+    error = H5Lite::writeScalarDataset(fileID, "Data/Added", 1);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Ldelete(fileID, "Data/Name", H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(!index.objectExists("Data/Added"));
+    error = index.refresh(fileID, "Data");
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(index.datasetExists("Data/Added"));
+    H5SUPPORT_REQUIRE(!index.objectExists("Data/Name"));
+    H5SUPPORT_REQUIRE(index.find("Data")->children == std::vector<std::string>({"Added", "Compressed"}));
+    error = H5Ldelete(fileID, "Data/Added", H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = index.refresh(fileID, "Data/Added");
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(!index.objectExists("Data/Added"));
+    H5SUPPORT_REQUIRE(index.find("Data")->children == std::vector<std::string>({"Compressed"}));
+    H5SUPPORT_REQUIRE(index.size() == 3);
+
+    // A single new leaf is inserted among its siblings in name order
+    error = H5Lite::writeScalarDataset(fileID, "Data/Aaa", 1);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = index.refresh(fileID, "Data/Aaa");
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(index.datasetExists("Data/Aaa"));
+    H5SUPPORT_REQUIRE(index.find("Data")->children == std::vector<std::string>({"Aaa", "Compressed"}));
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestListGroup()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5UtilTest::GroupTest);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    hid_t createPropertyList = H5Pcreate(H5P_GROUP_CREATE);
+    H5Pset_link_creation_order(createPropertyList, H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED);
+    hid_t groupID = H5Gcreate(fileID, "Ordered", H5P_DEFAULT, createPropertyList, H5P_DEFAULT);
+    H5Pclose(createPropertyList);
+    H5SUPPORT_REQUIRE(groupID > 0);
+    hid_t childID = H5Utilities::createGroup(groupID, "c_group");
+    H5Gclose(childID);
+    herr_t error = H5Lite::writeScalarDataset(groupID, "a_data", 1);
+    H5SUPPORT_REQUIRE(error >= 0);
+    childID = H5Utilities::createGroup(groupID, "b_group");
+    H5Gclose(childID);
+    error = H5Lcreate_soft("/DoesNotExist", groupID, "d_dangling", H5P_DEFAULT, H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    H5Utilities::GroupListing listing;
+    error = H5Utilities::listGroup(groupID, listing);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(listing.size() == 4);
+    H5SUPPORT_REQUIRE(std::string(listing.getName(0)) == "a_data");
+    H5SUPPORT_REQUIRE(std::string(listing.getName(3)) == "d_dangling");
+    H5SUPPORT_REQUIRE(listing.getCreationOrder(0) == 1);
+
+    error = H5Utilities::listGroup(groupID, listing, H5Utilities::CustomHDFDataTypes::Group | H5Utilities::CustomHDFDataTypes::Dataset, H5_INDEX_CRT_ORDER);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(listing.size() == 3);
+    H5SUPPORT_REQUIRE(std::string(listing.getName(0)) == "c_group");
+    H5SUPPORT_REQUIRE(listing.getType(0) == H5O_TYPE_GROUP);
+    H5SUPPORT_REQUIRE(std::string(listing.getName(1)) == "a_data");
+    H5SUPPORT_REQUIRE(listing.getType(1) == H5O_TYPE_DATASET);
+    H5SUPPORT_REQUIRE(listing.getCreationOrder(2) == 2);
+
+    error = H5Utilities::listGroup(groupID, listing, H5Utilities::CustomHDFDataTypes::Dataset);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(listing.size() == 1);
+
+    // A visitor can stop the iteration early
+    size_t visited = 0;
+    error = H5Utilities::iterateGroup(groupID, [&visited](const char* /*name*/, H5O_type_t type, int64_t /*creationOrder*/) -> herr_t {
+      visited++;
+      return type == H5O_TYPE_GROUP ? 1 : 0;
+    });
+    H5SUPPORT_REQUIRE(error == 1);
+    H5SUPPORT_REQUIRE(visited == 2);
+
+    // An exception from the visitor stops the iteration and reaches the caller
+    visited = 0;
+    bool caught = false;
+    try
+    {
+      H5ScopedErrorHandler errorHandler;
+      H5Utilities::iterateGroup(groupID, [&visited](const char* name, H5O_type_t /*type*/, int64_t /*creationOrder*/) -> herr_t {
+        visited++;
+        if(std::string(name) == "b_group")
+        {
+          throw std::runtime_error("Visitor failed");
+        }
+        return 0;
+      });
+    } catch(const std::runtime_error& e)
+    {
+      caught = std::string(e.what()) == "Visitor failed";
+    }
+    H5SUPPORT_REQUIRE(caught);
+    H5SUPPORT_REQUIRE(visited == 2);
+    error = H5Utilities::listGroup(groupID, listing);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(listing.size() == 4);
+
+    std::list<std::string> names;
+    error = H5Utilities::getGroupObjects(groupID, H5Utilities::CustomHDFDataTypes::Group, names);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(names == std::list<std::string>({"b_group", "c_group"}));
+
+    H5Gclose(groupID);
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestGroupCreateOptions()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5UtilTest::GroupTest);
+    H5SUPPORT_REQUIRE(fileID > 0);
+
+    GroupCreateOptions options;
+    options.setCreationOrder().setLinkPhaseChange(0, 0).setEstimatedLinkInfo(1000, 16);
+    herr_t error = static_cast<herr_t>(H5Utilities::createGroupsFromPath("/Large/Members", fileID, options));
+    H5SUPPORT_REQUIRE(error >= 0);
+    hid_t groupID = H5Gopen(fileID, "Large/Members", H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(groupID > 0);
+    hid_t createPropertyList = H5Gget_create_plist(groupID);
+    uint32_t creationOrderFlags = 0;
+    uint32_t maxCompact = 0;
+    uint32_t minDense = 0;
+    H5Pget_link_creation_order(createPropertyList, &creationOrderFlags);
+    H5Pget_link_phase_change(createPropertyList, &maxCompact, &minDense);
+    H5Pclose(createPropertyList);
+    H5SUPPORT_REQUIRE(creationOrderFlags == (H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED));
+    H5SUPPORT_REQUIRE(maxCompact == 0);
+
+    for(const std::string name : {"Zeta", "Alpha", "Mu"})
+    {
+      hid_t childID = H5Utilities::createGroup(groupID, name);
+      H5SUPPORT_REQUIRE(childID > 0);
+      H5Gclose(childID);
+    }
+    H5G_info_t groupInfo{};
+    H5Gget_info(groupID, &groupInfo);
+    H5SUPPORT_REQUIRE(groupInfo.storage_type == H5G_STORAGE_TYPE_DENSE);
+    std::string name;
+    error = H5Utilities::objectNameAtIndex(groupID, 0, name, H5_INDEX_CRT_ORDER);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(name == "Zeta");
+    name.clear();
+    error = H5Utilities::objectNameAtIndex(groupID, 2, name, H5_INDEX_CRT_ORDER);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(name == "Mu");
+    H5Gclose(groupID);
+
+    // Groups created without options keep the HDF5 defaults
+    groupID = H5Gopen(fileID, "Large", H5P_DEFAULT);
+    hid_t defaultID = H5Utilities::createGroup(groupID, "Default");
+    H5SUPPORT_REQUIRE(defaultID > 0);
+    createPropertyList = H5Gget_create_plist(defaultID);
+    H5Pget_link_creation_order(createPropertyList, &creationOrderFlags);
+    H5Pclose(createPropertyList);
+    H5SUPPORT_REQUIRE(creationOrderFlags == 0);
+    H5Gclose(defaultID);
+    H5Gclose(groupID);
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestGroupPathCache()
+  {
+    hid_t fileID = H5Utilities::createFile(UnitTest::H5UtilTest::GroupTest);
+    H5SUPPORT_REQUIRE(fileID > 0);
+    H5SUPPORT_REQUIRE(H5GroupPathCache::enable(fileID) >= 0);
+    H5SUPPORT_REQUIRE(H5GroupPathCache::isEnabled(fileID));
+
+    // Every missing group along the path is created in one call and remembered
+    GroupCreateOptions options;
+    options.setCreationOrder();
+    herr_t error = static_cast<herr_t>(H5Utilities::createGroupsFromPath("/A/B/C/D/", fileID, options));
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(H5Utilities::isGroup(fileID, "A/B/C/D"));
+    H5SUPPORT_REQUIRE(H5GroupPathCache::contains(fileID, "A/B/C/D"));
+    H5SUPPORT_REQUIRE(H5GroupPathCache::contains(fileID, "/A/B"));
+    hid_t groupID = H5Gopen(fileID, "A/B", H5P_DEFAULT);
+    H5SUPPORT_REQUIRE(groupID > 0);
+    H5SUPPORT_REQUIRE(H5GroupPathCache::contains(groupID, "C/D"));
+    hid_t createPropertyList = H5Gget_create_plist(groupID);
+    uint32_t creationOrderFlags = 0;
+    H5Pget_link_creation_order(createPropertyList, &creationOrderFlags);
+    H5Pclose(createPropertyList);
+    H5SUPPORT_REQUIRE(creationOrderFlags == (H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED));
+    error = static_cast<herr_t>(H5Utilities::createGroupsFromPath("C/E", groupID));
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(H5GroupPathCache::contains(fileID, "A/B/C/E"));
+    H5Gclose(groupID);
+
+    // Repeated calls are answered from the cache
+    error = static_cast<herr_t>(H5Utilities::createGroupsFromPath("A/B/C/D", fileID));
+    H5SUPPORT_REQUIRE(error >= 0);
+
+    // Datasets below deep paths get their parent groups through the same code
+    std::vector<int32_t> data = {1, 2, 3};
+    std::vector<hsize_t> dims = {3};
+    error = H5Utilities::createGroupsForDataset("/X/Y/Z/Data", fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    error = H5Lite::writeVectorDataset(fileID, "/X/Y/Z/Data", dims, data);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(H5GroupPathCache::contains(fileID, "X/Y/Z"));
+
+    // An object that is not a group can not be part of the path
+    error = static_cast<herr_t>(H5Utilities::createGroupsFromPath("X/Y/Z/Data", fileID));
+    H5SUPPORT_REQUIRE(error < 0);
+
+    // Groups unlinked outside of H5Support must be invalidated before they are created again
+    H5SUPPORT_REQUIRE(H5GroupPathCache::invalidate(fileID, "A/B/C") >= 0);
+    H5SUPPORT_REQUIRE(H5Ldelete(fileID, "A/B/C", H5P_DEFAULT) >= 0);
+    H5SUPPORT_REQUIRE(!H5GroupPathCache::contains(fileID, "A/B/C/D"));
+    H5SUPPORT_REQUIRE(!H5GroupPathCache::contains(fileID, "A/B/C"));
+    H5SUPPORT_REQUIRE(H5GroupPathCache::contains(fileID, "A/B"));
+    error = static_cast<herr_t>(H5Utilities::createGroupsFromPath("A/B/C/D", fileID));
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(H5Utilities::isGroup(fileID, "A/B/C/D"));
+
+    error = H5Utilities::closeFile(fileID);
+    H5SUPPORT_REQUIRE(error >= 0);
+    H5SUPPORT_REQUIRE(!H5GroupPathCache::isEnabled(fileID));
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -227,6 +809,14 @@ public:
   {
     H5SUPPORT_REGISTER_TEST(Test())
     H5SUPPORT_REGISTER_TEST(TestOpenSameFile2x())
+    H5SUPPORT_REGISTER_TEST(TestFileAccessOptions())
+    H5SUPPORT_REGISTER_TEST(TestFileImage())
+    H5SUPPORT_REGISTER_TEST(TestMetadataCacheImage())
+    H5SUPPORT_REGISTER_TEST(TestPagedFileSpace())
+    H5SUPPORT_REGISTER_TEST(TestFileIndex())
+    H5SUPPORT_REGISTER_TEST(TestListGroup())
+    H5SUPPORT_REGISTER_TEST(TestGroupCreateOptions())
+    H5SUPPORT_REGISTER_TEST(TestGroupPathCache())
     H5SUPPORT_REGISTER_TEST(RemoveTestFiles())
   }
 };
@@ -0,0 +1,153 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "H5Support/H5Lite.h"
+#include "H5Support/H5Utilities.h"
+
+using namespace H5Support;
+
+namespace
+{
+constexpr int32_t k_NumGroups = 2000;
+constexpr int32_t k_AttributesPerGroup = 8;
+
+/**
+ * @brief Writes k_NumGroups groups holding k_AttributesPerGroup scalar attributes each.
+ */
+bool writeFile(const std::string& filePath, const FileCreateOptions& createOptions)
+{
+  hid_t fileID = H5Utilities::createFile(filePath, FileAccessOptions(), createOptions);
+  if(fileID < 0)
+  {
+    std::cout << "Error creating " << filePath << std::endl;
+    return false;
+  }
+  for(int32_t i = 0; i < k_NumGroups; i++)
+  {
+    std::string groupName = "Group_" + std::to_string(i);
+    hid_t groupID = H5Utilities::createGroup(fileID, groupName);
+    H5Utilities::closeHDF5Object(groupID);
+    for(int32_t a = 0; a < k_AttributesPerGroup; a++)
+    {
+      if(H5Lite::writeScalarAttribute(fileID, groupName, "Attribute_" + std::to_string(a), i * a) < 0)
+      {
+        H5Utilities::closeFile(fileID);
+        return false;
+      }
+    }
+  }
+  H5Utilities::closeFile(fileID);
+  return true;
+}
+
+/**
+ * @brief Opens the file, reads every attribute with readScalarAttribute and returns the elapsed seconds,
+ * or a negative value on error.
+ */
+double readFile(const std::string& filePath, const FileAccessOptions& options)
+{
+  auto start = std::chrono::steady_clock::now();
+  hid_t fileID = H5Utilities::openFile(filePath, true, options);
+  if(fileID < 0)
+  {
+    std::cout << "Error opening " << filePath << std::endl;
+    return -1.0;
+  }
+  int64_t sum = 0;
+  for(int32_t i = 0; i < k_NumGroups; i++)
+  {
+    std::string groupName = "Group_" + std::to_string(i);
+    for(int32_t a = 0; a < k_AttributesPerGroup; a++)
+    {
+      int32_t value = 0;
+      if(H5Lite::readScalarAttribute(fileID, groupName, "Attribute_" + std::to_string(a), value) < 0)
+      {
+        H5Utilities::closeFile(fileID);
+        return -1.0;
+      }
+      sum += value;
+    }
+  }
+  H5Utilities::closeFile(fileID);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "    checksum " << sum << std::endl;
+  return elapsed.count();
+}
+} // namespace
+
+/**
+ * Compares readScalarAttribute heavy access on a file using the default aggregation strategy with the same
+ * file using paged aggregation and a page buffer. The difference is largest on network or spinning storage
+ * with a cold OS cache; pass a directory on such a device as the first argument and drop the caches between
+ * runs to see it.
+ */
+int main(int argc, char* argv[])
+{
+  std::string directory("/tmp");
+  if(argc > 1)
+  {
+    directory = argv[1];
+  }
+  const std::string defaultFile = directory + "/H5Support_PagedBenchmark_Default.h5";
+  const std::string pagedFile = directory + "/H5Support_PagedBenchmark_Paged.h5";
+
+  FileCreateOptions pagedCreateOptions;
+  pagedCreateOptions.setPagedFileSpace(64 * 1024);
+  if(!writeFile(defaultFile, FileCreateOptions()) || !writeFile(pagedFile, pagedCreateOptions))
+  {
+    return EXIT_FAILURE;
+  }
+
+  FileAccessOptions pageBufferOptions;
+  pageBufferOptions.setPageBufferSize(16 * 1024 * 1024);
+
+  std::cout << "Reading " << k_NumGroups * k_AttributesPerGroup << " attributes" << std::endl;
+  std::cout << "  Default aggregation:" << std::endl;
+  double defaultSeconds = readFile(defaultFile, FileAccessOptions());
+  std::cout << "    " << defaultSeconds << " s" << std::endl;
+  std::cout << "  Paged aggregation + 16 MB page buffer:" << std::endl;
+  double pagedSeconds = readFile(pagedFile, pageBufferOptions);
+  std::cout << "    " << pagedSeconds << " s" << std::endl;
+
+  std::remove(defaultFile.c_str());
+  std::remove(pagedFile.c_str());
+  return (defaultSeconds < 0.0 || pagedSeconds < 0.0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -18,6 +18,11 @@ endif()
 include(CMakeFindDependencyMacro)
 find_dependency(HDF5 MODULE)
 
+find_dependency(Threads)
+if(@H5Support_USE_PARALLEL_DEFLATE@)
+  find_dependency(ZLIB)
+endif()
+
 include("${CMAKE_CURRENT_LIST_DIR}/H5SupportTargets.cmake")
 
 set(H5Support_INCLUDE_DIRS "${CMAKE_CURRENT_LIST_DIR}/../../include")